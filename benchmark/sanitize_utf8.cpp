@@ -0,0 +1,126 @@
+// Micro-benchmark for the UTF-8 checks behind SanitizeUTF8 / AddSanitizedString.
+//
+// Compares the previous byte-by-byte sanitizer (always builds a new string) with the byte-at-a-time validator and
+// the vectorized one on typical CDX field values and on a larger non-ASCII document. Not part of the extension
+// build; from the repository root:
+//
+//   c++ -O2 -std=c++11 -Isrc/include benchmark/sanitize_utf8.cpp -o sanitize_utf8 && ./sanitize_utf8
+//   c++ -O2 -std=c++11 -mavx2 -Isrc/include benchmark/sanitize_utf8.cpp -o sanitize_utf8 && ./sanitize_utf8
+
+#include "web_archive_utf8.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using duckdb::IsValidUTF8;
+using duckdb::IsValidUTF8Scalar;
+using std::string;
+
+// SanitizeUTF8 before the vectorized check
+static string LegacySanitizeUTF8(const string &str) {
+	string result;
+	result.reserve(str.size());
+	for (size_t i = 0; i < str.size();) {
+		unsigned char c = static_cast<unsigned char>(str[i]);
+		if (c < 0x80) {
+			result += c;
+			i++;
+			continue;
+		}
+		int len = 0;
+		if ((c & 0xE0) == 0xC0) {
+			len = 2;
+		} else if ((c & 0xF0) == 0xE0) {
+			len = 3;
+		} else if ((c & 0xF8) == 0xF0) {
+			len = 4;
+		} else {
+			result += '?';
+			i++;
+			continue;
+		}
+		if (i + len > str.size()) {
+			result += '?';
+			break;
+		}
+		bool valid = true;
+		for (int j = 1; j < len; j++) {
+			if ((static_cast<unsigned char>(str[i + j]) & 0xC0) != 0x80) {
+				valid = false;
+				break;
+			}
+		}
+		if (valid) {
+			result.append(str, i, len);
+			i += len;
+		} else {
+			result += '?';
+			i++;
+		}
+	}
+	return result;
+}
+
+// SanitizeUTF8 now: validate, and only copy (here: return) the input when it is valid
+static string CurrentSanitizeUTF8(const string &str) {
+	if (IsValidUTF8(str.data(), str.size())) {
+		return str;
+	}
+	return LegacySanitizeUTF8(str);
+}
+
+template <class FUNC>
+static void Run(const char *name, const std::vector<string> &inputs, size_t iterations, FUNC func) {
+	size_t bytes = 0;
+	for (auto &input : inputs) {
+		bytes += input.size();
+	}
+	size_t checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		for (auto &input : inputs) {
+			checksum += func(input);
+		}
+	}
+	auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("  %-28s %8.1f ms %10.2f GB/s  (checksum %zu)\n", name, seconds * 1000,
+	       double(bytes) * double(iterations) / seconds / 1e9, checksum);
+}
+
+static void RunSuite(const char *title, const std::vector<string> &inputs, size_t iterations) {
+	printf("%s\n", title);
+	Run("legacy sanitize (copy)", inputs, iterations,
+	    [](const string &s) { return LegacySanitizeUTF8(s).size(); });
+	Run("current sanitize", inputs, iterations, [](const string &s) { return CurrentSanitizeUTF8(s).size(); });
+	Run("validate, byte at a time", inputs, iterations,
+	    [](const string &s) { return size_t(IsValidUTF8Scalar(s.data(), s.size())); });
+	Run("validate, vectorized", inputs, iterations,
+	    [](const string &s) { return size_t(IsValidUTF8(s.data(), s.size())); });
+}
+
+int main() {
+	// Shapes of the cells the CDX scans write: URLs, MIME types, SHA-1 digests, WARC filenames
+	std::vector<string> cdx_fields;
+	for (int i = 0; i < 10000; i++) {
+		cdx_fields.push_back("https://www.example.com/articles/2024/" + std::to_string(i) + "/index.html?page=2");
+		cdx_fields.push_back("text/html");
+		cdx_fields.push_back("sha1:3I42H3S6NNFQ2MSVX7XZKYAYSCX5QBYJ");
+		cdx_fields.push_back("crawl-data/CC-MAIN-2024-10/segments/1707947473347.0/warc/CC-MAIN-20240220211055-" +
+		                     std::to_string(i) + ".warc.gz");
+	}
+	RunSuite("CDX field values (ASCII)", cdx_fields, 200);
+
+	// A page body mixing ASCII markup with multi-byte text
+	string document;
+	while (document.size() < (1 << 20)) {
+		document += "<p>Grüße aus Köln — 東京の天気は晴れです。 Привет, мир! 🎉</p>\n";
+	}
+	RunSuite("1 MB mixed UTF-8 document", std::vector<string> {document}, 200);
+
+	// A value with one invalid byte still goes through the repairing path
+	std::vector<string> invalid {string("https://example.com/caf\xe9-menu")};
+	RunSuite("Invalid value", invalid, 1000000);
+	return 0;
+}
@@ -6,5 +6,11 @@ duckdb_extension_load(cloudflare
     LOAD_TESTS
 )
 
+# common_crawl_index / wayback_machine; its tests are under test/sql with cloudflare's
+duckdb_extension_load(web_archive
+    SOURCE_DIR ${CMAKE_CURRENT_LIST_DIR}/web_archive
+    INCLUDE_DIR ${CMAKE_CURRENT_LIST_DIR}/src/include
+)
+
 # Any extra extensions that should be built
 # e.g.: duckdb_extension_load(json)
\ No newline at end of file
@@ -1,5 +1,13 @@
 #include "web_archive_utils.hpp"
+#include "web_archive_cache.hpp"
+#include "web_archive_fetch.hpp"
+#include "web_archive_http.hpp"
+#include "single_flight.hpp"
+#include <algorithm>
+#include <deque>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_comparison_expression.hpp"
 #include "duckdb/planner/expression/bound_columnref_expression.hpp"
@@ -10,6 +18,7 @@
 #include "duckdb/planner/operator/logical_get.hpp"
 #include "duckdb/planner/operator/logical_limit.hpp"
 #include "duckdb/logging/logger.hpp"
+#include "duckdb/common/string_util.hpp"
 
 namespace duckdb {
 
@@ -26,34 +35,111 @@ struct CommonCrawlBindData : public TableFunctionData {
 	vector<string> fields_needed;
 	bool fetch_response;
 	string url_filter;
+	vector<string> url_filters; // Several URL patterns (url IN (...) / OR of url LIKEs): each is queried separately
 	vector<string> cdx_filters; // CDX API filter parameters (e.g., "=status:200", "=mime:text/html")
 	idx_t max_results;          // Maximum number of results to fetch from CDX API
+	idx_t total_limit;          // LIMIT pushed into the scan: rows over all crawls (CDX_NO_LIMIT = none)
 	timestamp_t timestamp_from; // Timestamp range filter (from collinfo.json lookup)
 	timestamp_t timestamp_to;   // Timestamp range filter (from collinfo.json lookup)
 	bool has_timestamp_filter;  // Whether timestamp filters were applied
 	bool debug;                 // Show cdx_url column when true
 	string cdx_url;             // The constructed CDX API URL (populated after query)
 	int timeout_seconds;        // Timeout for fetch operations (default 180)
+	idx_t prefetch;             // WARC fetches kept in flight ahead of the scan (default 64)
+	string source;              // Index backend: "cdx" (CDX server API), "zipnum" or "parquet" (cc-index table)
+	string index_path;          // ZipNum/Parquet index location; empty uses the public one
+	idx_t max_body_bytes;       // Response body bytes inflated per record (WARC_NO_BODY_LIMIT = whole body)
 
 	// Default CDX limit set to 100 to prevent fetching too many results
 	CommonCrawlBindData(string index)
 	    : index_name(std::move(index)), fetch_response(false), url_filter("*"), max_results(100),
-	      timestamp_from(timestamp_t(0)), timestamp_to(timestamp_t(0)), has_timestamp_filter(false), debug(false),
-	      timeout_seconds(180) {
+	      total_limit(CDX_NO_LIMIT), timestamp_from(timestamp_t(0)), timestamp_to(timestamp_t(0)),
+	      has_timestamp_filter(false), debug(false), timeout_seconds(180), prefetch(64), source("cdx"),
+	      max_body_bytes(DConstants::INVALID_INDEX) {
 	}
 };
 
+// Output columns of common_crawl_index, resolved from the projection once per scan
+enum class CommonCrawlColumn : uint8_t {
+	URL,
+	TIMESTAMP,
+	MIMETYPE,
+	STATUSCODE,
+	DIGEST,
+	FILENAME,
+	OFFSET,
+	LENGTH,
+	CRAWL_ID,
+	WARC,
+	RESPONSE,
+	CDX_URL,
+	OTHER // e.g. virtual columns; left untouched
+};
+
+static CommonCrawlColumn ResolveCommonCrawlColumn(const CommonCrawlBindData &bind_data, column_t col_id) {
+	if (col_id >= bind_data.column_names.size()) {
+		return CommonCrawlColumn::OTHER;
+	}
+	auto &name = bind_data.column_names[col_id];
+	if (name == "url") {
+		return CommonCrawlColumn::URL;
+	} else if (name == "timestamp") {
+		return CommonCrawlColumn::TIMESTAMP;
+	} else if (name == "mimetype") {
+		return CommonCrawlColumn::MIMETYPE;
+	} else if (name == "statuscode") {
+		return CommonCrawlColumn::STATUSCODE;
+	} else if (name == "digest") {
+		return CommonCrawlColumn::DIGEST;
+	} else if (name == "filename") {
+		return CommonCrawlColumn::FILENAME;
+	} else if (name == "offset") {
+		return CommonCrawlColumn::OFFSET;
+	} else if (name == "length") {
+		return CommonCrawlColumn::LENGTH;
+	} else if (name == "crawl_id") {
+		return CommonCrawlColumn::CRAWL_ID;
+	} else if (name == "warc") {
+		return CommonCrawlColumn::WARC;
+	} else if (name == "response") {
+		return CommonCrawlColumn::RESPONSE;
+	} else if (name == "cdx_url") {
+		return CommonCrawlColumn::CDX_URL;
+	}
+	return CommonCrawlColumn::OTHER;
+}
+
+class MultiCrawlScheduler;
+
 // Structure to hold global state for the table function
 struct CommonCrawlGlobalState : public GlobalTableFunctionState {
-	vector<CDXRecord> records;
-	idx_t current_position;
-	vector<column_t> column_ids; // Which columns are actually selected
+	CDXRecordSet records;                // Index results, one columnar batch per crawl
+	vector<column_t> column_ids;         // Which columns are actually selected
+	vector<CommonCrawlColumn> columns;   // column_ids resolved to output columns (one per output vector)
+	vector<bool> warc_fields;            // warc STRUCT fields the query reads (version, headers)
+	vector<bool> response_fields;        // response STRUCT fields the query reads (body, headers, ...)
+	RecordRangeDispenser ranges;         // Record ranges handed out to scan threads
+	FetchPipeline<WARCResponse> fetches; // WARC fetches submitted ahead of the scan threads
+	unique_ptr<MultiCrawlScheduler> crawls; // Multi-crawl scans: crawls still to be read
+	std::mutex crawl_lock;                  // Held while a scan thread waits for the next crawl
+	idx_t expected_ranges = 1;              // Multi-crawl scans: ranges expected once all crawls are in
+
+	~CommonCrawlGlobalState() override; // Defined once MultiCrawlScheduler is complete
 
-	CommonCrawlGlobalState() : current_position(0) {
+	idx_t MaxThreads() const override {
+		// One thread per record range; DuckDB caps this at its own thread count
+		return MaxValue<idx_t>(ranges.RangeCount(), expected_ranges);
 	}
+};
 
-	idx_t MaxThreads() const override {
-		return 1; // Single-threaded for now
+// Per-thread scan state: the record range currently being emitted
+struct CommonCrawlLocalState : public LocalTableFunctionState {
+	idx_t position;
+	idx_t range_end;
+	idx_t batch_index;
+	PendingFetches<WARCResponse> fetches; // WARC fetches for [position, range_end)
+
+	CommonCrawlLocalState() : position(0), range_end(0), batch_index(0) {
 	}
 };
 
@@ -61,12 +147,146 @@ struct CommonCrawlGlobalState : public GlobalTableFunctionState {
 // CDX API QUERY
 // ========================================
 
+static constexpr const char *CDX_HOST = "index.commoncrawl.org";
+// Longest a single index request may take; one page can hold many thousands of lines
+static constexpr int CDX_REQUEST_TIMEOUT_SECONDS = 300;
+
+// Run an index request through the thread's libcurl client. attempt sends it once (starting over each time) and
+// returns the response; connection failures, throttling and server errors are retried with the host's backoff.
+// Throws IOException once the request cannot succeed.
+static void RequestCDX(ClientContext &context, const string &url, const std::function<RangeResponse()> &attempt) {
+	const int max_retries = 5;
+	int retry_delay_ms = 100;
+	auto &executor = FetchExecutor::Get();
+
+	for (int i = 0; i < max_retries; i++) {
+		if (i > 0) {
+			auto delay_ms = executor.RetryDelayMs(CDX_HOST, retry_delay_ms);
+			DUCKDB_LOG_DEBUG(context, "CDX retry %d/%d after %dms for: %s", i, max_retries - 1, delay_ms,
+			                 url.c_str());
+			std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+			retry_delay_ms *= 2; // Exponential backoff
+		}
+		auto response = attempt();
+		executor.RecordResponse(CDX_HOST, response.status, response.retry_after, response.latency_ms);
+		if (response.error.empty()) {
+			return;
+		}
+		if (!response.Retryable()) {
+			throw IOException(response.error);
+		}
+		if (i + 1 == max_retries) {
+			throw IOException("Failed after " + to_string(max_retries) + " retries: " + response.error);
+		}
+	}
+}
+
+// Stream a CDX query and parse its NDJSON lines as they arrive (at most max_records in total). records is
+// replaced with the result; a retried request starts over from an empty batch.
+static void StreamCDXRecords(ClientContext &context, const string &url, const string &index_name,
+                             bool need_warc_fields, idx_t max_records, CDXRecordBatch &records) {
+	idx_t line_count = 0;
+	// Each line is parsed into the same scratch record and then appended to the batch's columns
+	CDXRecord record;
+	auto &client = RangeHttpClient::ThreadLocal();
+	RequestCDX(context, url, [&]() {
+		line_count = 0;
+		records = CDXRecordBatch();
+		records.crawl_id = index_name;
+		CDXLineReader reader([&](const char *line, idx_t length) {
+			if (records.Size() >= max_records) {
+				return false;
+			}
+			if (length == 0 || line[0] != '{') {
+				return true;
+			}
+			line_count++;
+			record.Clear();
+			if (ParseCDXJsonLine(line, length, index_name, need_warc_fields, record)) {
+				records.Append(record);
+			}
+			return records.Size() < max_records;
+		});
+		auto response = client.Stream(
+		    url, [&reader](const char *data, idx_t size) { return reader.Feed(data, size); },
+		    CDX_REQUEST_TIMEOUT_SECONDS);
+		if (response.error.empty()) {
+			reader.Finish();
+		}
+		return response;
+	});
+	DUCKDB_LOG_DEBUG(context, "Parsed %lu JSON lines, got %lu records +%.0fms", (unsigned long)line_count,
+	                 (unsigned long)records.Size(), ElapsedMs());
+}
+
+// Parse the response of a showNumPages=true query: {"pages": 12, "pageSize": 5, "blocks": 58} (or a bare number)
+static idx_t ParseCDXPageCount(const string &response) {
+	auto pos = response.find("\"pages\"");
+	pos = pos == string::npos ? 0 : response.find(':', pos) + 1;
+	while (pos < response.size() && (response[pos] == ' ' || response[pos] == '\t')) {
+		pos++;
+	}
+	idx_t pages = 0;
+	while (pos < response.size() && response[pos] >= '0' && response[pos] <= '9') {
+		pages = pages * 10 + (response[pos] - '0');
+		pos++;
+	}
+	return pages;
+}
+
+// Fetch a paginated Common Crawl CDX query: pages are requested concurrently, a wave of
+// index-host capacity at a time, and appended in page order until max_results records are in
+static void QueryCDXPages(ClientContext &context, const string &base_url, const string &index_name,
+                          bool need_warc_fields, idx_t max_results, CDXRecordBatch &records) {
+	const string host = CDX_HOST;
+	string page_count_url = base_url + "&showNumPages=true";
+	string page_count_response;
+	auto &client = RangeHttpClient::ThreadLocal();
+	RequestCDX(context, page_count_url,
+	           [&]() { return client.Get(page_count_url, page_count_response, CDX_REQUEST_TIMEOUT_SECONDS); });
+	idx_t page_count = ParseCDXPageCount(page_count_response);
+	DUCKDB_LOG_DEBUG(context, "CDX query has %lu pages +%.0fms", (unsigned long)page_count, ElapsedMs());
+
+	idx_t wave_size = FetchExecutor::HostConcurrencyLimit(host);
+	for (idx_t first_page = 0; first_page < page_count && records.Size() < max_results; first_page += wave_size) {
+		idx_t wave_end = MinValue<idx_t>(first_page + wave_size, page_count);
+		// Each page is parsed by the task that streams it, so parsing also runs in parallel
+		vector<std::future<CDXRecordBatch>> pages;
+		for (idx_t page = first_page; page < wave_end; page++) {
+			string page_url = base_url + "&page=" + to_string(page);
+			pages.push_back(FetchExecutor::Get().SubmitTask<CDXRecordBatch>(
+			    host, [&context, page_url, index_name, need_warc_fields, max_results]() {
+				    CDXRecordBatch page_records;
+				    StreamCDXRecords(context, page_url, index_name, need_warc_fields, max_results, page_records);
+				    return page_records;
+			    }));
+		}
+		// Wait for the whole wave before collecting so no task outlives this call on error
+		for (auto &page : pages) {
+			page.wait();
+		}
+		for (auto &page : pages) {
+			auto page_records = page.get();
+			idx_t take = MinValue<idx_t>(page_records.Size(), max_results - records.Size());
+			records.AppendRows(page_records, 0, take);
+		}
+	}
+}
+
+// Common Crawl CDX queries in flight, across all queries
+static SingleFlight<CDXRecordBatch> &CDXQueryFlights() {
+	// Intentionally leaked, like the fetch executor: queries may still be running at process exit
+	static auto flights = new SingleFlight<CDXRecordBatch>();
+	return *flights;
+}
+
 // Helper function to query CDX API using FileSystem
-static vector<CDXRecord> QueryCDXAPI(ClientContext &context, const string &index_name, const string &url_pattern,
-                                     const vector<string> &fields_needed, const vector<string> &cdx_filters,
-                                     idx_t max_results, timestamp_t ts_from, timestamp_t ts_to, string &out_cdx_url) {
+static CDXRecordBatch QueryCDXAPI(ClientContext &context, const string &index_name, const string &url_pattern,
+                                  const vector<string> &fields_needed, const vector<string> &cdx_filters,
+                                  idx_t max_results, timestamp_t ts_from, timestamp_t ts_to, string &out_cdx_url) {
 	DUCKDB_LOG_DEBUG(context, "QueryCDXAPI started +%.0fms", ElapsedMs());
-	vector<CDXRecord> records;
+	CDXRecordBatch records;
+	records.crawl_id = index_name;
 
 	// Helper lambda to map DuckDB column names to CDX API field names
 	auto map_column_to_field = [](const string &col_name) -> string {
@@ -94,24 +314,29 @@ static vector<CDXRecord> QueryCDXAPI(ClientContext &context, const string &index
 	}
 
 	// Construct the CDX API URL
-	// Add limit parameter to control how many results we fetch
-	string cdx_url = "https://index.commoncrawl.org/" + index_name + "-index?url=" + url_pattern +
-	                 "&output=json&fl=" + field_list + "&limit=" + to_string(max_results);
+	string base_url =
+	    "https://index.commoncrawl.org/" + index_name + "-index?url=" + url_pattern + "&output=json&fl=" + field_list;
 
 	// Add timestamp range parameters (from/to) if specified
 	// CDX API expects timestamps in YYYYMMDDHHMMSS format (14 digits)
 	if (ts_from.value != 0) {
 		string from_str = ToCdxTimestamp(Timestamp::ToString(ts_from));
-		cdx_url += "&from=" + from_str;
+		base_url += "&from=" + from_str;
 	}
 	if (ts_to.value != 0) {
 		string to_str = ToCdxTimestamp(Timestamp::ToString(ts_to));
-		cdx_url += "&to=" + to_str;
+		base_url += "&to=" + to_str;
 	}
 
 	// Add filter parameters (e.g., filter==statuscode:200)
 	for (const auto &filter : cdx_filters) {
-		cdx_url += "&filter=" + filter;
+		base_url += "&filter=" + filter;
+	}
+
+	// Add limit parameter to control how many results we fetch (none when every page is wanted)
+	string cdx_url = base_url;
+	if (max_results != CDX_NO_LIMIT) {
+		cdx_url += "&limit=" + to_string(max_results);
 	}
 
 	// Debug: print the final CDX URL
@@ -120,187 +345,698 @@ static vector<CDXRecord> QueryCDXAPI(ClientContext &context, const string &index
 	// Store the CDX URL for output
 	out_cdx_url = cdx_url;
 
-	try {
-		DUCKDB_LOG_DEBUG(context, "Opening CDX URL +%.0fms", ElapsedMs());
-		// Set force_download to skip HEAD request
-		context.db->GetDatabase(context).config.SetOption("force_download", Value(true));
-
-		// Use FileSystem to fetch the CDX data
-		auto &fs = FileSystem::GetFileSystem(context);
-		auto file_handle = fs.OpenFile(cdx_url, FileFlags::FILE_FLAGS_READ);
-
-		DUCKDB_LOG_DEBUG(context, "Reading CDX response +%.0fms", ElapsedMs());
-		// Read the entire response
-		string response_data;
-		const idx_t buffer_size = 8192;
-		auto buffer = unique_ptr<char[]>(new char[buffer_size]);
-
-		while (true) {
-			int64_t bytes_read = file_handle->Read(buffer.get(), buffer_size);
-			if (bytes_read <= 0) {
-				break;
+	// Indexed crawls are finished and never change, so cached results never expire
+	auto cdx_cache = DiskCache::Get(context, "cdx");
+	auto cache_key = NormalizeCDXUrl(cdx_url);
+	string cached;
+	if (cdx_cache && cdx_cache->Read(cache_key, cached) && DeserializeCDXRecords(cached, records)) {
+		DUCKDB_LOG_DEBUG(context, "CDX cache hit: %lu records +%.0fms", (unsigned long)records.Size(), ElapsedMs());
+		return records;
+	}
+
+	auto download = [&]() {
+		CDXRecordBatch fetched_records;
+		fetched_records.crawl_id = index_name;
+		try {
+			if (max_results <= CDX_SINGLE_REQUEST_MAX) {
+				DUCKDB_LOG_DEBUG(context, "Opening CDX URL +%.0fms", ElapsedMs());
+				StreamCDXRecords(context, cdx_url, index_name, need_warc_fields, max_results, fetched_records);
+			} else {
+				// Large results: walk the index pages instead of one huge request
+				QueryCDXPages(context, base_url, index_name, need_warc_fields, max_results, fetched_records);
 			}
-			response_data.append(buffer.get(), bytes_read);
+		} catch (std::exception &ex) {
+			throw IOException("Error querying CDX API: " + string(ex.what()));
+		} catch (...) {
+			throw IOException("Unknown error querying CDX API");
 		}
 
-		DUCKDB_LOG_DEBUG(context, "Got %lu bytes, sanitizing UTF-8 +%.0fms", (unsigned long)response_data.size(),
-		                 ElapsedMs());
-		// Sanitize the entire response to ensure valid UTF-8
-		response_data = SanitizeUTF8(response_data);
-		DUCKDB_LOG_DEBUG(context, "UTF-8 sanitization complete +%.0fms", ElapsedMs());
-
-		// Parse newline-delimited JSON
-		DUCKDB_LOG_DEBUG(context, "Parsing JSON lines +%.0fms", ElapsedMs());
-		std::istringstream stream(response_data);
-		string line;
-		int line_count = 0;
-
-		while (std::getline(stream, line)) {
-			if (line.empty() || line[0] != '{') {
-				continue;
-			}
-			line_count++;
+		if (cdx_cache) {
+			auto encoded = SerializeCDXRecords(fetched_records);
+			cdx_cache->Write(cache_key, encoded.data(), encoded.size());
+		}
+		return fetched_records;
+	};
 
-			CDXRecord record;
+	// The same query running concurrently (e.g. dashboards refreshing in parallel) shares one download
+	bool joined = false;
+	auto fetched = CDXQueryFlights().Do(cache_key, download, &joined);
+	if (joined) {
+		DUCKDB_LOG_DEBUG(context, "Shared an in-flight CDX query: %lu records +%.0fms", (unsigned long)fetched->Size(),
+		                 ElapsedMs());
+	}
+	return *fetched;
+}
 
-			// Extract fields from JSON line
-			record.url = ExtractJSONValue(line, "url");
-			if (record.url.empty()) {
-				continue; // Skip invalid records
-			}
+// Look up one crawl in the index backend chosen by the source parameter
+static CDXRecordBatch QueryCrawlIndex(ClientContext &context, const CommonCrawlBindData &bind_data,
+                                      const string &crawl_id, const string &url_pattern,
+                                      const vector<string> &fields_needed, idx_t max_results, string &out_index_url) {
+	if (bind_data.source == "zipnum") {
+		auto index_path = bind_data.index_path.empty() ? string(ZIPNUM_DEFAULT_INDEX_PATH) : bind_data.index_path;
+		return QueryZipNumIndex(context, index_path, crawl_id, url_pattern, bind_data.cdx_filters, max_results,
+		                        bind_data.timestamp_from, bind_data.timestamp_to, out_index_url);
+	}
+	if (bind_data.source == "parquet") {
+		auto index_path = bind_data.index_path.empty() ? string(PARQUET_DEFAULT_INDEX_PATH) : bind_data.index_path;
+		return QueryParquetIndex(context, index_path, crawl_id, url_pattern, bind_data.cdx_filters, max_results,
+		                         bind_data.timestamp_from, bind_data.timestamp_to, out_index_url);
+	}
+	return QueryCDXAPI(context, crawl_id, url_pattern, fields_needed, bind_data.cdx_filters, max_results,
+	                   bind_data.timestamp_from, bind_data.timestamp_to, out_index_url);
+}
 
-			record.timestamp = ExtractJSONValue(line, "timestamp");
-			record.mime_type = ExtractJSONValue(line, "mime");
-			record.digest = ExtractJSONValue(line, "digest");
-			record.crawl_id = index_name;
+// ========================================
+// MULTI-CRAWL SCHEDULING
+// ========================================
 
-			string status_str = ExtractJSONValue(line, "status");
-			record.status_code = status_str.empty() ? 0 : std::stoi(status_str);
+// Most index queries of one scan in flight at once
+static constexpr idx_t MULTI_CRAWL_MAX_CONCURRENT_QUERIES = 4;
+
+// Queries the crawls of a scan newest first, once per URL pattern (url IN (...) / OR of url LIKEs), and hands out
+// the results one query at a time, so the scan emits the first query's rows while later ones are still running.
+// - At most MULTI_CRAWL_MAX_CONCURRENT_QUERIES queries run at once. With a LIMIT, the first query runs alone and
+//   later waves are sized by the rows per query seen so far
+// - Each query asks for the rows still missing, so a productive query pages further while sparse ones return what
+//   they have
+// - With several patterns, a capture matched by more than one of them (same url and timestamp) is emitted once
+// - No further query is started once the LIMIT is met
+class MultiCrawlScheduler {
+public:
+	MultiCrawlScheduler(ClientContext &context, const CommonCrawlBindData &bind_data, vector<string> url_patterns,
+	                    vector<string> fields_needed)
+	    : context(context), bind_data(bind_data), url_patterns(std::move(url_patterns)),
+	      fields_needed(std::move(fields_needed)), crawl_ids(bind_data.crawl_ids), next_query(0), rows(0),
+	      queries_done(0) {
+		if (crawl_ids.empty()) {
+			crawl_ids.push_back(bind_data.index_name);
+		}
+		// Crawl ids (CC-MAIN-YYYY-WW) sort by date
+		std::sort(crawl_ids.begin(), crawl_ids.end(), std::greater<string>());
+		crawl_ids.erase(std::unique(crawl_ids.begin(), crawl_ids.end()), crawl_ids.end());
+	}
 
-			if (need_warc_fields) {
-				record.filename = ExtractJSONValue(line, "filename");
-				string offset_str = ExtractJSONValue(line, "offset");
-				string length_str = ExtractJSONValue(line, "length");
+	idx_t QueryCount() const {
+		return crawl_ids.size() * url_patterns.size();
+	}
 
-				record.offset = offset_str.empty() ? 0 : std::stoll(offset_str);
-				record.length = length_str.empty() ? 0 : std::stoll(length_str);
+	// Wait for the next query with results; false once every query is done or the LIMIT is met
+	bool Next(CDXRecordBatch &batch) {
+		while (Remaining() > 0) {
+			StartQueries();
+			if (pending.empty()) {
+				return false;
+			}
+			auto query = std::move(pending.front());
+			pending.pop_front();
+			batch = query->result.get();
+			queries_done++;
+			if (url_patterns.size() > 1) {
+				RemoveSeenCaptures(batch);
+			}
+			if (batch.Size() > Remaining()) {
+				// Queries started together may overshoot the LIMIT between them
+				CDXRecordBatch trimmed;
+				trimmed.crawl_id = batch.crawl_id;
+				trimmed.AppendRows(batch, 0, Remaining());
+				batch = std::move(trimmed);
 			}
+			batch.index_url = *query->index_url;
+			rows += batch.Size();
+			DUCKDB_LOG_DEBUG(context,
+			                 "Crawl %s, pattern %s returned %lu records (%lu in total, %lu queries in flight) +%.0fms",
+			                 query->crawl_id.c_str(), query->url_pattern.c_str(), (unsigned long)batch.Size(),
+			                 (unsigned long)rows, (unsigned long)pending.size(), ElapsedMs());
+			if (batch.Size() > 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	struct PendingQuery {
+		string crawl_id;
+		string url_pattern;
+		shared_ptr<string> index_url; // Written by the query
+		std::future<CDXRecordBatch> result;
+	};
+
+	idx_t Remaining() const {
+		return bind_data.total_limit == CDX_NO_LIMIT ? CDX_NO_LIMIT : bind_data.total_limit - rows;
+	}
 
-			records.push_back(record);
+	// Drop the rows of captures an earlier pattern already returned, keeping runs of new rows together
+	void RemoveSeenCaptures(CDXRecordBatch &batch) {
+		CDXRecordBatch unseen;
+		unseen.crawl_id = batch.crawl_id;
+		idx_t run_start = 0;
+		for (idx_t row = 0; row < batch.Size(); row++) {
+			string key(batch.url.Data(row), batch.url.Length(row));
+			key.append(reinterpret_cast<const char *>(&batch.timestamp[row]), sizeof(timestamp_t));
+			if (!seen_captures.insert(std::move(key)).second) {
+				unseen.AppendRows(batch, run_start, row - run_start);
+				run_start = row + 1;
+			}
+		}
+		if (run_start == 0) {
+			return;
 		}
-		DUCKDB_LOG_DEBUG(context, "Parsed %d JSON lines, got %lu records +%.0fms", line_count,
-		                 (unsigned long)records.size(), ElapsedMs());
+		unseen.AppendRows(batch, run_start, batch.Size() - run_start);
+		batch = std::move(unseen);
+	}
 
-	} catch (std::exception &ex) {
-		throw IOException("Error querying CDX API: " + string(ex.what()));
-	} catch (...) {
-		throw IOException("Unknown error querying CDX API");
+	void StartQueries() {
+		idx_t window = MULTI_CRAWL_MAX_CONCURRENT_QUERIES;
+		if (bind_data.total_limit != CDX_NO_LIMIT) {
+			// Rows per query so far tell how many more queries the LIMIT likely needs
+			idx_t rows_per_query = queries_done == 0 ? Remaining() : rows / queries_done;
+			if (rows_per_query > 0) {
+				idx_t queries_needed = (Remaining() + rows_per_query - 1) / rows_per_query;
+				window = MinValue<idx_t>(window, MaxValue<idx_t>(queries_needed, 1));
+			}
+		}
+		while (pending.size() < window && next_query < QueryCount()) {
+			// Crawl by crawl, each crawl's patterns in filter order
+			auto query = make_uniq<PendingQuery>();
+			query->crawl_id = crawl_ids[next_query / url_patterns.size()];
+			query->url_pattern = url_patterns[next_query % url_patterns.size()];
+			query->index_url = make_shared_ptr<string>();
+			next_query++;
+			auto query_max_results = MinValue<idx_t>(bind_data.max_results, Remaining());
+			auto crawl_id = query->crawl_id;
+			auto url_pattern = query->url_pattern;
+			auto index_url = query->index_url;
+			// pending is destroyed first, so queries never outlive the scheduler
+			query->result =
+			    std::async(std::launch::async, [this, crawl_id, url_pattern, query_max_results, index_url]() {
+				    return QueryCrawlIndex(context, bind_data, crawl_id, url_pattern, fields_needed, query_max_results,
+				                           *index_url);
+			    });
+			pending.push_back(std::move(query));
+		}
 	}
 
-	return records;
+	ClientContext &context;
+	const CommonCrawlBindData &bind_data;
+	vector<string> url_patterns;
+	vector<string> fields_needed;
+	vector<string> crawl_ids; // Newest first
+	idx_t next_query;         // Next (crawl, pattern) pair to query
+	idx_t rows;               // Rows handed out so far
+	idx_t queries_done;       // Queries that completed
+	// url + timestamp of every capture handed out (only with several patterns)
+	std::unordered_set<string> seen_captures;
+	// Queries in flight, in query order; a std::async future waits for its query when destroyed
+	std::deque<unique_ptr<PendingQuery>> pending;
+};
+
+CommonCrawlGlobalState::~CommonCrawlGlobalState() {
 }
 
 // ========================================
 // WARC FETCHING
 // ========================================
 
-// Helper function to fetch WARC response using FileSystem API with retry and timeout
-static WARCResponse FetchWARCResponse(ClientContext &context, const CDXRecord &record,
-                                      std::chrono::steady_clock::time_point start_time, int timeout_seconds) {
-	WARCResponse result;
-
-	if (record.filename.empty() || record.offset == 0 || record.length == 0) {
-		return result; // Invalid record - return empty
-	}
-
+// Largest gap between two records in the same WARC file that is still read in one request
+static constexpr idx_t WARC_COALESCE_MAX_GAP = 32 * 1024;
+// Upper bound on the size of one coalesced range read
+static constexpr idx_t WARC_COALESCE_MAX_SPAN = 4 * 1024 * 1024;
+// No cap on the inflated body of a WARC record
+static constexpr idx_t WARC_NO_BODY_LIMIT = DConstants::INVALID_INDEX;
+// Bytes read beyond a capped body to cover the WARC/HTTP headers and deflate overhead
+static constexpr idx_t WARC_PREFIX_READ_SLACK = 64 * 1024;
+
+// Fields of the warc STRUCT column
+static constexpr idx_t WARC_VERSION_FIELD = 0;
+static constexpr idx_t WARC_HEADERS_FIELD = 1;
+static constexpr idx_t WARC_STRUCT_FIELDS = 2;
+// Fields of the response STRUCT column
+static constexpr idx_t RESPONSE_BODY_FIELD = 0;
+static constexpr idx_t RESPONSE_HEADERS_FIELD = 1;
+static constexpr idx_t RESPONSE_HTTP_VERSION_FIELD = 2;
+static constexpr idx_t RESPONSE_ERROR_FIELD = 3;
+static constexpr idx_t RESPONSE_TRUNCATED_FIELD = 4;
+static constexpr idx_t RESPONSE_STRUCT_FIELDS = 5;
+
+// Host serving the WARC files
+static constexpr const char *WARC_HOST = "data.commoncrawl.org";
+
+// Read bytes [offset, offset + length) of a WARC file with one ranged GET per attempt, with retry and timeout.
+// Every response is reported to the fetch executor, which adapts the host's concurrency to it.
+// Returns false and sets error when the read failed.
+static bool DownloadWARCBytes(ClientContext &context, const string &filename, idx_t offset, idx_t length,
+                              std::chrono::steady_clock::time_point start_time, int timeout_seconds,
+                              unique_ptr<char[]> &buffer, idx_t &bytes_read, string &error) {
 	// Construct the WARC URL
-	string warc_url = "https://data.commoncrawl.org/" + record.filename;
+	string warc_url = "https://" + string(WARC_HOST) + "/" + filename;
 
-	// Retry with exponential backoff: 100ms, 200ms, 400ms, 800ms, 1600ms
+	// Retry with jittered exponential backoff from 100ms, stretched to the host's Retry-After pause
 	const int max_retries = 5;
 	int retry_delay_ms = 100;
 	string last_error;
 
+	// Allocate buffer for the compressed data; the client writes straight into it
+	buffer = unique_ptr<char[]>(new char[length]);
+	auto &client = RangeHttpClient::ThreadLocal();
+	auto &executor = FetchExecutor::Get();
+
 	for (int attempt = 0; attempt < max_retries; attempt++) {
 		// Check if timeout exceeded
 		auto elapsed =
 		    std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - start_time).count();
 		if (elapsed >= timeout_seconds) {
-			result.error = "Timeout after " + to_string(elapsed) + "s (limit: " + to_string(timeout_seconds) + "s)";
+			error = "Timeout after " + to_string(elapsed) + "s (limit: " + to_string(timeout_seconds) + "s)";
 			DUCKDB_LOG_DEBUG(context, "Fetch timeout for WARC: %s", warc_url.c_str());
-			return result;
+			return false;
 		}
 
-		try {
-			if (attempt > 0) {
-				DUCKDB_LOG_DEBUG(context, "Retry %d/%d after %dms for WARC: %s", attempt, max_retries - 1,
-				                 retry_delay_ms / 2, warc_url.c_str());
-				std::this_thread::sleep_for(std::chrono::milliseconds(retry_delay_ms));
-				retry_delay_ms *= 2; // Exponential backoff
+		if (attempt > 0) {
+			auto delay_ms = executor.RetryDelayMs(WARC_HOST, retry_delay_ms);
+			DUCKDB_LOG_DEBUG(context, "Retry %d/%d after %dms for WARC: %s", attempt, max_retries - 1, delay_ms,
+			                 warc_url.c_str());
+			std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+			retry_delay_ms *= 2; // Exponential backoff
+		}
+
+		auto remaining = timeout_seconds - static_cast<int>(elapsed);
+		auto response = client.GetRange(warc_url, offset, length, buffer.get(), remaining);
+		executor.RecordResponse(WARC_HOST, response.status, response.retry_after, response.latency_ms);
+		if (response.error.empty()) {
+			if (response.bytes_read == 0) {
+				last_error = "Failed to read data from WARC file";
+				continue; // Retry
 			}
+			bytes_read = response.bytes_read;
+			return true;
+		}
+
+		last_error = response.error;
+		// Retry on connection errors, throttling and server-side failures; a Retry-After pauses the whole host
+		if (!response.Retryable()) {
+			error = last_error;
+			return false;
+		}
+	}
+
+	// All retries failed
+	error = "Failed after " + to_string(max_retries) + " retries: " + last_error;
+	return false;
+}
 
-			// Set force_download to skip HEAD request
-			context.db->GetDatabase(context).config.SetOption("force_download", Value(true));
+// A downloaded WARC range, shared by every concurrent read of that range
+struct WARCBytes {
+	unique_ptr<char[]> data;
+	idx_t size = 0;
+	string error; // Empty on success
+};
 
-			// Get the file system from the database context
-			auto &fs = FileSystem::GetFileSystem(context);
+// WARC range reads in flight, across all queries
+static SingleFlight<WARCBytes> &WARCReadFlights() {
+	// Intentionally leaked, like the fetch executor whose threads use it
+	static auto flights = new SingleFlight<WARCBytes>();
+	return *flights;
+}
 
-			// Open the file through httpfs (HTTP URLs are handled when httpfs is loaded)
-			auto file_handle = fs.OpenFile(warc_url, FileFlags::FILE_FLAGS_READ);
+// Read bytes [offset, offset + length) of a WARC file. An identical read already in flight (from this or another
+// query) is joined instead of downloading the range again, unless join_in_flight is false.
+static std::shared_ptr<const WARCBytes> FetchWARCBytes(ClientContext &context, const string &filename, idx_t offset,
+                                                       idx_t length, int timeout_seconds, bool join_in_flight) {
+	auto download = [&]() {
+		WARCBytes bytes;
+		// Timeout budget starts when the download actually begins, not when it was queued
+		if (!DownloadWARCBytes(context, filename, offset, length, std::chrono::steady_clock::now(), timeout_seconds,
+		                       bytes.data, bytes.size, bytes.error) &&
+		    bytes.error.empty()) {
+			bytes.error = "Failed to read data from WARC file";
+		}
+		return bytes;
+	};
+	if (!join_in_flight) {
+		return std::make_shared<WARCBytes>(download());
+	}
+	auto key = filename + ":" + to_string(offset) + ":" + to_string(length);
+	bool joined = false;
+	auto bytes = WARCReadFlights().Do(key, download, &joined);
+	if (joined) {
+		DUCKDB_LOG_DEBUG(context, "Shared an in-flight read of WARC range %s", key.c_str());
+	}
+	return bytes;
+}
 
-			// Allocate buffer for the compressed data
-			auto buffer = unique_ptr<char[]>(new char[record.length]);
+// Per-scan settings shared by all WARC fetch tasks
+struct WARCFetchOptions {
+	std::shared_ptr<std::atomic<bool>> cancelled; // Set once the scan is torn down
+	std::shared_ptr<RunningTaskCount> running;    // Fetch copies the scan waits for before tearing down
+	int timeout_seconds = 180;
+	shared_ptr<DiskCache> cache;               // Local content cache (nullptr when disabled)
+	bool reuse_bodies = false;                 // Only body, truncated and error are read: equal digests share them
+	shared_ptr<BodyCache> bodies;              // Bodies by digest (nullptr when disabled or not reused)
+	shared_ptr<DiskCache> body_store;          // Persisted bodies by digest (nullptr without the local cache)
+	idx_t max_body_bytes = WARC_NO_BODY_LIMIT; // Body bytes inflated per record (0 = headers only)
+	bool parse_warc_headers = true;            // Build the warc.headers map
+	bool parse_http_headers = true;            // Build the response.headers map
+};
 
-			// Seek to the offset and read the specified length
-			// httpfs should translate this into HTTP Range request: bytes=offset-(offset+length-1)
-			file_handle->Seek(record.offset);
-			int64_t bytes_read = file_handle->Read(buffer.get(), record.length);
+// Decompress one gzip WARC record and parse the HTTP response out of it.
+// With a body cap, inflation stops once the headers and max_body_bytes of body are out and the body is marked
+// truncated. Returns false when data is only a prefix of the record that ends before that point.
+static bool DecodeWARCRecord(const char *data, idx_t size, const WARCFetchOptions &options, WARCResponse &result) {
+	auto max_body_bytes = options.max_body_bytes;
+	if (max_body_bytes == WARC_NO_BODY_LIMIT) {
+		// The data we read is gzip compressed
+		// We need to decompress it to get the WARC content
+		*result.data = DecompressGzip(data, size);
+
+		// Parse the WARC format to locate WARC/HTTP headers and body in place
+		if (result.data->find("[Error") == 0) {
+			// If decompression returned an error message, set it as error
+			result.error = std::move(*result.data);
+			result.data->clear();
+			return true;
+		}
+		ParseWARCResponse(result, options.parse_warc_headers, options.parse_http_headers);
+		return true;
+	}
 
-			if (bytes_read <= 0) {
-				last_error = "Failed to read data from WARC file";
-				continue; // Retry
-			}
+	auto &decompressed = *result.data;
+	auto status = DecompressGzipPrefix(
+	    data, size,
+	    [max_body_bytes](const string &out) {
+		    auto payload_start = FindWARCPayloadStart(out);
+		    return payload_start != string::npos && out.size() - payload_start >= max_body_bytes;
+	    },
+	    decompressed);
+	if (decompressed.find("[Error") == 0) {
+		result.error = std::move(decompressed);
+		decompressed.clear();
+		return true;
+	}
+	if (status == GzipPrefixResult::INPUT_EXHAUSTED) {
+		return false;
+	}
+	ParseWARCResponse(result, options.parse_warc_headers, options.parse_http_headers);
+	if (status == GzipPrefixResult::STOPPED || result.body.length > max_body_bytes) {
+		result.body.length = MinValue<idx_t>(result.body.length, max_body_bytes);
+		result.body_truncated = true;
+	}
+	return true;
+}
+
+// Where a record sits in its WARC file
+struct WARCLocation {
+	string filename;
+	int64_t offset = 0;
+	int64_t length = 0;
+};
+
+static bool IsFetchableRecord(const WARCLocation &record) {
+	return !record.filename.empty() && record.offset != 0 && record.length != 0;
+}
+
+// Cache key of a WARC record: its exact byte range
+static string WARCCacheKey(const WARCLocation &record) {
+	return record.filename + ":" + to_string(record.offset) + ":" + to_string(record.length);
+}
+
+// Bytes of a record to request: with a body cap, a prefix that normally holds the headers and the capped body.
+// Deflate never expands data by more than a few bytes per 64KB block, so the slack covers headers and overhead.
+static idx_t WARCReadLength(const WARCLocation &record, idx_t max_body_bytes) {
+	auto length = NumericCast<idx_t>(record.length);
+	if (max_body_bytes == WARC_NO_BODY_LIMIT || max_body_bytes >= length) {
+		return length;
+	}
+	return MinValue<idx_t>(length, max_body_bytes + max_body_bytes / 64 + WARC_PREFIX_READ_SLACK);
+}
+
+// Decode a fetched record (or prefix of one); when the prefix is too short, read the whole record and retry
+static WARCResponse DecodeFetchedRecord(ClientContext &context, const WARCLocation &record, const char *data,
+                                        idx_t size, const WARCFetchOptions &options) {
+	WARCResponse response;
+	try {
+		if (DecodeWARCRecord(data, size, options, response)) {
+			return response;
+		}
+		if (size >= NumericCast<idx_t>(record.length)) {
+			response.error = "Truncated gzip WARC record";
+			return response;
+		}
+		DUCKDB_LOG_DEBUG(context, "WARC prefix of %llu bytes too short, reading all %lld bytes of %s",
+		                 (unsigned long long)size, (long long)record.length, record.filename.c_str());
+		auto bytes = FetchWARCBytes(context, record.filename, record.offset, record.length, options.timeout_seconds,
+		                            true);
+		if (!bytes->error.empty()) {
+			response.error = bytes->error;
+			return response;
+		}
+		if (options.cache && bytes->size == NumericCast<idx_t>(record.length)) {
+			options.cache->Write(WARCCacheKey(record), bytes->data.get(), bytes->size);
+		}
+		if (!DecodeWARCRecord(bytes->data.get(), bytes->size, options, response)) {
+			response.error = "Truncated gzip WARC record";
+		}
+	} catch (std::exception &ex) {
+		response.error = ex.what();
+	}
+	return response;
+}
+
+// Body cache key of a Common Crawl record: its payload digest
+static string WARCBodyCacheKey(const string &digest) {
+	return "cc:" + digest;
+}
+
+// Response of a body-only scan served from the body cache, capped like a fetched body
+static WARCResponse CachedBodyResponse(shared_ptr<string> body, idx_t max_body_bytes) {
+	WARCResponse response;
+	response.body.offset = 0;
+	response.body.length = body->size();
+	response.data = std::move(body);
+	if (max_body_bytes != WARC_NO_BODY_LIMIT && response.body.length > max_body_bytes) {
+		response.body.length = max_body_bytes;
+		response.body_truncated = true;
+	}
+	return response;
+}
+
+// Records of a fetch window waiting on the same WARC record: the record itself and later ones with its digest
+typedef vector<std::promise<WARCResponse>> WARCResponseWaiters;
+
+// Records of one WARC file that are read with a single range request
+struct WARCReadGroup {
+	string filename;
+	idx_t start = 0; // First byte of the range
+	idx_t end = 0;   // One past the last byte of the range
+	vector<WARCLocation> members;
+	vector<string> digests; // Body cache key part of each member (empty when bodies are not reused)
+	vector<std::shared_ptr<WARCResponseWaiters>> waiters;
+};
+
+// Outcome of reading a group: its members from the content cache, or its byte range from the network
+struct WARCGroupRead {
+	vector<string> cached;                  // One entry per member when served from the cache
+	std::shared_ptr<const WARCBytes> bytes; // The group's range otherwise
+	string error;                           // Empty on success
+};
+
+// Read every member of a group from the content cache; false if any member is missing
+static bool ReadWARCGroupFromCache(const WARCReadGroup &group, const WARCFetchOptions &options,
+                                   vector<string> &cached) {
+	cached.resize(group.members.size());
+	for (idx_t i = 0; i < group.members.size(); i++) {
+		if (!options.cache->Read(WARCCacheKey(group.members[i]), cached[i])) {
+			cached.clear();
+			return false;
+		}
+	}
+	return true;
+}
+
+// Fetch the whole range of a group once (or take its members from the cache). Runs on the executor and may run
+// twice when hedged, so it leaves the group's promises alone; the hedge copy downloads on its own.
+static WARCGroupRead ReadWARCGroup(ClientContext &context, const WARCReadGroup &group, const WARCFetchOptions &options,
+                                   bool hedge) {
+	WARCGroupRead read;
+	if (options.cancelled->load()) {
+		read.error = "Fetch cancelled";
+		return read;
+	}
+	if (options.cache && ReadWARCGroupFromCache(group, options, read.cached)) {
+		return read;
+	}
+	read.bytes = FetchWARCBytes(context, group.filename, group.start, group.end - group.start,
+	                            options.timeout_seconds, !hedge);
+	read.error = read.bytes->error;
+	return read;
+}
 
-			// The data we read is gzip compressed
-			// We need to decompress it to get the WARC content
-			string decompressed = DecompressGzip(buffer.get(), bytes_read);
+// Hand a member's response to every record waiting on it; complete bodies are kept for later captures of the
+// same digest
+static void DeliverWARCMember(const WARCReadGroup &group, idx_t member, const WARCFetchOptions &options,
+                              WARCResponse response) {
+	if (options.bodies && !group.digests[member].empty() && response.error.empty() && !response.body_truncated) {
+		options.bodies->Write(WARCBodyCacheKey(group.digests[member]),
+		                      make_shared_ptr<string>(response.Ptr(response.body), response.body.length),
+		                      options.body_store.get());
+	}
+	auto &waiters = *group.waiters[member];
+	for (idx_t i = 0; i + 1 < waiters.size(); i++) {
+		waiters[i].set_value(response);
+	}
+	waiters.back().set_value(std::move(response));
+}
 
-			// Parse the WARC format to extract HTTP response headers and body
-			if (decompressed.find("[Error") == 0) {
-				// If decompression returned an error message, set it as error
-				result.error = decompressed;
-				return result;
+// Cut each member's gzip record out of a group read, decode it and fulfil the promises waiting on it
+static void DeliverWARCGroup(ClientContext &context, const WARCReadGroup &group, const WARCFetchOptions &options,
+                             WARCGroupRead &read) {
+	if (!read.cached.empty()) {
+		for (idx_t i = 0; i < group.members.size(); i++) {
+			auto &record = group.members[i];
+			DeliverWARCMember(
+			    group, i, options,
+			    DecodeFetchedRecord(context, record, read.cached[i].data(), read.cached[i].size(), options));
+		}
+		return;
+	}
+	bool ok = read.error.empty();
+	idx_t bytes_read = ok ? read.bytes->size : 0;
+	if (ok && group.members.size() > 1) {
+		DUCKDB_LOG_DEBUG(context, "Coalesced %llu WARC records into one %llu byte read of %s",
+		                 (unsigned long long)group.members.size(), (unsigned long long)bytes_read,
+		                 group.filename.c_str());
+	}
+
+	for (idx_t i = 0; i < group.members.size(); i++) {
+		auto &record = group.members[i];
+		WARCResponse response;
+		if (!ok) {
+			response.error = read.error;
+		} else {
+			idx_t member_offset = record.offset - group.start;
+			if (member_offset >= bytes_read) {
+				response.error = "Failed to read data from WARC file";
+			} else {
+				idx_t member_size =
+				    MinValue<idx_t>(WARCReadLength(record, options.max_body_bytes), bytes_read - member_offset);
+				auto member_data = read.bytes->data.get() + member_offset;
+				if (options.cache && member_size == NumericCast<idx_t>(record.length)) {
+					// Stored compressed, exactly as fetched
+					options.cache->Write(WARCCacheKey(record), member_data, member_size);
+				}
+				response = DecodeFetchedRecord(context, record, member_data, member_size, options);
 			}
+		}
+		DeliverWARCMember(group, i, options, std::move(response));
+	}
+}
 
-			return ParseWARCResponse(decompressed);
-
-		} catch (Exception &ex) {
-			last_error = ex.what();
-			// Check for retryable HTTP errors (503, 504)
-			string error_str = last_error;
-			bool is_retryable = error_str.find("503") != string::npos || error_str.find("504") != string::npos ||
-			                    error_str.find("Service Unavailable") != string::npos ||
-			                    error_str.find("Gateway Timeout") != string::npos ||
-			                    error_str.find("connection") != string::npos ||
-			                    error_str.find("timeout") != string::npos;
-			if (!is_retryable && attempt == 0) {
-				// Non-retryable error on first attempt, fail immediately
-				result.error = last_error;
-				return result;
+// Queue WARC fetches for records [begin, end) on the shared executor.
+// Records of the same file that sit close together are merged into one range read; the gzip
+// members are split apart again after the read. Futures are appended to out in record order.
+// When bodies are reused, only the first record of each digest in the window is fetched and the others get
+// copies of its response; digests found in the body cache are not fetched at all.
+static void SubmitWARCFetches(ClientContext &context, const CDXRecordSet &records, idx_t begin, idx_t end,
+                              std::shared_ptr<WARCFetchOptions> options, vector<std::future<WARCResponse>> &out) {
+	idx_t first_out = out.size();
+	out.resize(first_out + (end - begin));
+
+	// Copy the window's WARC locations out of the batches, ordered by file and offset so neighbouring
+	// records end up next to each other
+	vector<WARCLocation> locations(end - begin);
+	vector<string> digests(end - begin);
+	vector<std::shared_ptr<WARCResponseWaiters>> waiters(end - begin);
+	std::unordered_map<string, std::shared_ptr<WARCResponseWaiters>> by_digest;
+	idx_t shared = 0;
+	vector<idx_t> order;
+	for (idx_t i = begin; i < end; i++) {
+		idx_t row = i;
+		auto &batch = records.Locate(row);
+		auto &location = locations[i - begin];
+		location.filename.assign(batch.filename.Data(row), batch.filename.Length(row));
+		location.offset = batch.offset[row];
+		location.length = batch.length[row];
+		if (!IsFetchableRecord(location)) {
+			// Invalid record - resolve to an empty response without touching the network
+			std::promise<WARCResponse> empty;
+			empty.set_value(WARCResponse());
+			out[first_out + (i - begin)] = empty.get_future();
+			continue;
+		}
+		auto &digest = digests[i - begin];
+		if (options->reuse_bodies) {
+			digest.assign(batch.digest.Data(row), batch.digest.Length(row));
+		}
+		if (!digest.empty()) {
+			auto entry = by_digest.find(digest);
+			if (entry != by_digest.end()) {
+				entry->second->emplace_back();
+				out[first_out + (i - begin)] = entry->second->back().get_future();
+				shared++;
+				continue;
+			}
+			shared_ptr<string> body;
+			if (options->bodies) {
+				body = options->bodies->Read(WARCBodyCacheKey(digest), options->body_store.get());
+			}
+			if (body) {
+				std::promise<WARCResponse> cached;
+				cached.set_value(CachedBodyResponse(std::move(body), options->max_body_bytes));
+				out[first_out + (i - begin)] = cached.get_future();
+				continue;
 			}
-			// Continue to retry on retryable errors
-		} catch (std::exception &ex) {
-			last_error = ex.what();
-			// Continue to retry on connection errors
-		} catch (...) {
-			last_error = "Unknown error";
-			// Continue to retry
 		}
+		auto record_waiters = std::make_shared<WARCResponseWaiters>(1);
+		out[first_out + (i - begin)] = record_waiters->back().get_future();
+		if (!digest.empty()) {
+			by_digest[digest] = record_waiters;
+		}
+		waiters[i - begin] = std::move(record_waiters);
+		order.push_back(i - begin);
+	}
+	if (shared > 0) {
+		DUCKDB_LOG_DEBUG(context, "%llu of %llu WARC records share a digest with an earlier record",
+		                 (unsigned long long)shared, (unsigned long long)(end - begin));
+	}
+	std::sort(order.begin(), order.end(), [&locations](idx_t a, idx_t b) {
+		if (locations[a].filename != locations[b].filename) {
+			return locations[a].filename < locations[b].filename;
+		}
+		return locations[a].offset < locations[b].offset;
+	});
+
+	vector<WARCReadGroup> groups;
+	for (auto index : order) {
+		auto &record = locations[index];
+		idx_t record_end = record.offset + WARCReadLength(record, options->max_body_bytes);
+		bool extend = false;
+		if (!groups.empty()) {
+			auto &last = groups.back();
+			extend = last.filename == record.filename && record.offset <= last.end + WARC_COALESCE_MAX_GAP &&
+			         MaxValue<idx_t>(last.end, record_end) - last.start <= WARC_COALESCE_MAX_SPAN;
+		}
+		if (!extend) {
+			WARCReadGroup group;
+			group.filename = record.filename;
+			group.start = record.offset;
+			group.end = record_end;
+			groups.push_back(std::move(group));
+		}
+		auto &group = groups.back();
+		group.end = MaxValue<idx_t>(group.end, record_end);
+		group.members.push_back(record);
+		group.digests.push_back(std::move(digests[index]));
+		group.waiters.push_back(std::move(waiters[index]));
 	}
 
-	// All retries failed
-	result.error = "Failed after " + to_string(max_retries) + " retries: " + last_error;
-	return result;
+	// Slow reads are hedged with a second copy; whichever finishes first fulfils the members' promises
+	for (auto &group_entry : groups) {
+		auto group = std::make_shared<WARCReadGroup>(std::move(group_entry));
+		FetchExecutor::Get().SubmitHedged<WARCGroupRead>(
+		    WARC_HOST,
+		    [&context, group, options](bool hedge) { return ReadWARCGroup(context, *group, *options, hedge); },
+		    [&context, group, options](WARCGroupRead &read) { DeliverWARCGroup(context, *group, *options, read); },
+		    options->running);
+	}
 }
 
 // ========================================
@@ -322,7 +1058,9 @@ static unique_ptr<FunctionData> CommonCrawlBind(ClientContext &context, TableFun
 			if (kv.second.type().id() != LogicalTypeId::BIGINT) {
 				throw BinderException("common_crawl_index max_results parameter must be an integer");
 			}
-			bind_data->max_results = kv.second.GetValue<int64_t>();
+			// Negative max_results lifts the cap: every page of the CDX result is fetched
+			auto max_results = kv.second.GetValue<int64_t>();
+			bind_data->max_results = max_results < 0 ? CDX_NO_LIMIT : NumericCast<idx_t>(max_results);
 			DUCKDB_LOG_DEBUG(context, "CDX API max_results set to: %lu", (unsigned long)bind_data->max_results);
 		} else if (kv.first == "debug") {
 			if (kv.second.type().id() != LogicalTypeId::BOOLEAN) {
@@ -336,6 +1074,31 @@ static unique_ptr<FunctionData> CommonCrawlBind(ClientContext &context, TableFun
 			}
 			bind_data->timeout_seconds = kv.second.GetValue<int64_t>();
 			DUCKDB_LOG_DEBUG(context, "Timeout set to: %d seconds", bind_data->timeout_seconds);
+		} else if (kv.first == "prefetch") {
+			if (kv.second.type().id() != LogicalTypeId::BIGINT || kv.second.GetValue<int64_t>() <= 0) {
+				throw BinderException("common_crawl_index prefetch parameter must be a positive integer");
+			}
+			bind_data->prefetch = kv.second.GetValue<int64_t>();
+			DUCKDB_LOG_DEBUG(context, "Prefetch depth set to: %lu", (unsigned long)bind_data->prefetch);
+		} else if (kv.first == "source") {
+			auto source = StringUtil::Lower(kv.second.ToString());
+			if (kv.second.IsNull() || (source != "cdx" && source != "zipnum" && source != "parquet")) {
+				throw BinderException("common_crawl_index source parameter must be 'cdx', 'zipnum' or 'parquet'");
+			}
+			bind_data->source = source;
+			DUCKDB_LOG_DEBUG(context, "Index source set to: %s", bind_data->source.c_str());
+		} else if (kv.first == "index_path") {
+			if (kv.second.IsNull()) {
+				throw BinderException("common_crawl_index index_path parameter must be a path or URL");
+			}
+			bind_data->index_path = kv.second.ToString();
+			DUCKDB_LOG_DEBUG(context, "Index path set to: %s", bind_data->index_path.c_str());
+		} else if (kv.first == "max_body_bytes") {
+			if (kv.second.type().id() != LogicalTypeId::BIGINT || kv.second.GetValue<int64_t>() < 0) {
+				throw BinderException("common_crawl_index max_body_bytes parameter must be a non-negative integer");
+			}
+			bind_data->max_body_bytes = kv.second.GetValue<int64_t>();
+			DUCKDB_LOG_DEBUG(context, "Response bodies capped at %lu bytes", (unsigned long)bind_data->max_body_bytes);
 		} else {
 			throw BinderException("Unknown parameter '%s' for common_crawl_index", kv.first.c_str());
 		}
@@ -387,13 +1150,15 @@ static unique_ptr<FunctionData> CommonCrawlBind(ClientContext &context, TableFun
 	return_types.push_back(LogicalType::STRUCT(warc_children));
 
 	// Add response STRUCT with HTTP response details
-	// Fields: body (BLOB), headers (MAP), http_version (VARCHAR), error (VARCHAR)
+	// Fields: body (BLOB), headers (MAP), http_version (VARCHAR), error (VARCHAR),
+	// truncated (BOOLEAN: body cut at max_body_bytes)
 	names.push_back("response");
 	child_list_t<LogicalType> response_children;
 	response_children.push_back(make_pair("body", LogicalType::BLOB));
 	response_children.push_back(make_pair("headers", LogicalType::MAP(LogicalType::VARCHAR, LogicalType::VARCHAR)));
 	response_children.push_back(make_pair("http_version", LogicalType::VARCHAR));
 	response_children.push_back(make_pair("error", LogicalType::VARCHAR));
+	response_children.push_back(make_pair("truncated", LogicalType::BOOLEAN));
 	return_types.push_back(LogicalType::STRUCT(response_children));
 
 	// Add cdx_url column only when debug := true
@@ -419,8 +1184,8 @@ static unique_ptr<GlobalTableFunctionState> CommonCrawlInitGlobal(ClientContext
 	DUCKDB_LOG_DEBUG(context, "CommonCrawlInitGlobal called +%.0fms", ElapsedMs());
 	auto &bind_data = const_cast<CommonCrawlBindData &>(input.bind_data->Cast<CommonCrawlBindData>());
 
-	// Validate URL filter - don't allow queries without a specific URL
-	if (bind_data.url_filter == "*" || bind_data.url_filter.empty()) {
+	// Validate URL filter - don't allow queries without a specific URL (or URL patterns)
+	if (bind_data.url_filters.empty() && (bind_data.url_filter == "*" || bind_data.url_filter.empty())) {
 		throw InvalidInputException("common_crawl_index() requires a URL filter. Use WHERE url LIKE '%.example.com/%' "
 		                            "or WHERE url LIKE 'https://example.com/%'");
 	}
@@ -460,6 +1225,7 @@ static unique_ptr<GlobalTableFunctionState> CommonCrawlInitGlobal(ClientContext
 	string proj_cols_str;
 	for (auto &col_id : input.column_ids) {
 		proj_cols_str += to_string(col_id) + " ";
+		state->columns.push_back(ResolveCommonCrawlColumn(bind_data, col_id));
 	}
 	DUCKDB_LOG_DEBUG(context, "Projected columns: %s +%.0fms", proj_cols_str.c_str(), ElapsedMs());
 
@@ -471,8 +1237,25 @@ static unique_ptr<GlobalTableFunctionState> CommonCrawlInitGlobal(ClientContext
 	// Determine which fields are actually needed based on projection
 	vector<string> needed_fields;
 	bool need_response = false;
+	bool projects_warc = false;
+	bool projects_response = false;
 	bool need_warc = false;
 
+	// Struct fields of warc/response the query reads; the fetch only goes as deep as they require
+	state->warc_fields = vector<bool>(WARC_STRUCT_FIELDS, true);
+	state->response_fields = vector<bool>(RESPONSE_STRUCT_FIELDS, true);
+	for (auto &column : input.column_indexes) {
+		auto col_id = column.GetPrimaryIndex();
+		if (col_id >= bind_data.column_names.size()) {
+			continue;
+		}
+		if (bind_data.column_names[col_id] == "warc") {
+			state->warc_fields = ProjectedStructFields(column, WARC_STRUCT_FIELDS);
+		} else if (bind_data.column_names[col_id] == "response") {
+			state->response_fields = ProjectedStructFields(column, RESPONSE_STRUCT_FIELDS);
+		}
+	}
+
 	for (auto &col_id : input.column_ids) {
 		if (col_id < bind_data.column_names.size()) {
 			string col_name = bind_data.column_names[col_id];
@@ -481,6 +1264,8 @@ static unique_ptr<GlobalTableFunctionState> CommonCrawlInitGlobal(ClientContext
 			// Check if we need to fetch WARC data for this column
 			if (col_name == "warc" || col_name == "response") {
 				need_response = true;
+				projects_warc = projects_warc || col_name == "warc";
+				projects_response = projects_response || col_name == "response";
 				need_warc = true; // WARC response parsing requires filename/offset/length
 			} else if (col_name == "filename" || col_name == "offset" || col_name == "length") {
 				need_warc = true;
@@ -509,6 +1294,18 @@ static unique_ptr<GlobalTableFunctionState> CommonCrawlInitGlobal(ClientContext
 		}
 	}
 
+	// Without response.body only the headers are inflated (and, where possible, downloaded);
+	// truncated describes the body, so it needs the body inflated up to the cap as well
+	bool need_body = projects_response && (state->response_fields[RESPONSE_BODY_FIELD] ||
+	                                       state->response_fields[RESPONSE_TRUNCATED_FIELD]);
+	// Captures with the same digest share their body, but not their WARC or HTTP headers: bodies are only reused
+	// when nothing else of the record is read
+	bool reuse_bodies = need_body && !projects_warc && !state->response_fields[RESPONSE_HEADERS_FIELD] &&
+	                    !state->response_fields[RESPONSE_HTTP_VERSION_FIELD];
+	if (reuse_bodies && std::find(needed_fields.begin(), needed_fields.end(), "digest") == needed_fields.end()) {
+		needed_fields.push_back("digest");
+	}
+
 	// Override fetch_response based on projection
 	bind_data.fetch_response = need_response;
 	DUCKDB_LOG_DEBUG(context, "fetch_response = %d, need_warc = %d +%.0fms", bind_data.fetch_response, need_warc,
@@ -519,244 +1316,337 @@ static unique_ptr<GlobalTableFunctionState> CommonCrawlInitGlobal(ClientContext
 	if (needed_fields.empty()) {
 		needed_fields.push_back("url");
 	}
+	// Captures matched by several URL patterns are recognized by url and timestamp
+	if (!bind_data.url_filters.empty()) {
+		for (auto field : {"url", "timestamp"}) {
+			if (std::find(needed_fields.begin(), needed_fields.end(), field) == needed_fields.end()) {
+				needed_fields.push_back(field);
+			}
+		}
+	}
 
 	// Use the URL filter from bind data (could be set via filter pushdown)
 	string url_pattern = bind_data.url_filter;
 	DUCKDB_LOG_DEBUG(context, "About to call QueryCDXAPI with %lu fields +%.0fms", (unsigned long)needed_fields.size(),
 	                 ElapsedMs());
 
-	// Query CDX API - handle multiple crawl_ids if IN clause was used
-	if (!bind_data.crawl_ids.empty()) {
-		// IN clause detected: query each crawl_id in parallel and combine results
-		DUCKDB_LOG_DEBUG(context, "Launching %lu parallel CDX API requests +%.0fms",
-		                 (unsigned long)bind_data.crawl_ids.size(), ElapsedMs());
-
-		// For parallel queries, store each CDX URL
-		vector<string> cdx_urls;
-		cdx_urls.resize(bind_data.crawl_ids.size());
-
-		std::vector<std::future<vector<CDXRecord>>> futures;
-		futures.reserve(bind_data.crawl_ids.size());
-
-		// Launch async requests for each crawl_id
-		for (size_t i = 0; i < bind_data.crawl_ids.size(); i++) {
-			const auto &crawl_id = bind_data.crawl_ids[i];
-			futures.push_back(std::async(
-			    std::launch::async, [&context, crawl_id, url_pattern, &needed_fields, &bind_data, &cdx_urls, i]() {
-				    return QueryCDXAPI(context, crawl_id, url_pattern, needed_fields, bind_data.cdx_filters,
-				                       bind_data.max_results, bind_data.timestamp_from, bind_data.timestamp_to,
-				                       cdx_urls[i]);
-			    }));
-		}
-
-		// Collect results from all futures
-		for (auto &future : futures) {
-			auto records = future.get();
-			state->records.insert(state->records.end(), records.begin(), records.end());
-		}
-
-		// Store all CDX URLs (joined with newlines for debug output)
-		for (size_t i = 0; i < cdx_urls.size(); i++) {
-			if (i > 0)
-				bind_data.cdx_url += "\n";
-			bind_data.cdx_url += cdx_urls[i];
+	// Query CDX API - handle multiple crawl_ids / URL patterns if IN clauses or ORs were used
+	if (!bind_data.crawl_ids.empty() || !bind_data.url_filters.empty()) {
+		// Several crawls or patterns: the scan reads them newest crawl first as their queries complete
+		auto url_patterns = bind_data.url_filters.empty() ? vector<string> {url_pattern} : bind_data.url_filters;
+		state->crawls = make_uniq<MultiCrawlScheduler>(context, bind_data, url_patterns, needed_fields);
+		state->records.Reserve(state->crawls->QueryCount());
+		idx_t expected_rows = bind_data.total_limit;
+		if (expected_rows == CDX_NO_LIMIT && bind_data.max_results != CDX_NO_LIMIT) {
+			expected_rows = bind_data.max_results * state->crawls->QueryCount();
 		}
-
-		DUCKDB_LOG_DEBUG(context, "All parallel requests completed, total records: %lu +%.0fms",
-		                 (unsigned long)state->records.size(), ElapsedMs());
+		idx_t range_size = bind_data.fetch_response ? RESPONSE_SCAN_RANGE_SIZE : STANDARD_VECTOR_SIZE;
+		state->expected_ranges =
+		    expected_rows == CDX_NO_LIMIT ? DConstants::INVALID_INDEX : (expected_rows + range_size - 1) / range_size;
+		DUCKDB_LOG_DEBUG(context, "Scanning %lu crawls x %lu URL patterns newest first +%.0fms",
+		                 (unsigned long)(state->crawls->QueryCount() / url_patterns.size()),
+		                 (unsigned long)url_patterns.size(), ElapsedMs());
 	} else {
 		// Single crawl_id: use index_name
-		state->records =
-		    QueryCDXAPI(context, bind_data.index_name, url_pattern, needed_fields, bind_data.cdx_filters,
-		                bind_data.max_results, bind_data.timestamp_from, bind_data.timestamp_to, bind_data.cdx_url);
-		DUCKDB_LOG_DEBUG(context, "QueryCDXAPI returned %lu records +%.0fms", (unsigned long)state->records.size(),
+		auto records = QueryCrawlIndex(context, bind_data, bind_data.index_name, url_pattern, needed_fields,
+		                               bind_data.max_results, bind_data.cdx_url);
+		records.index_url = bind_data.cdx_url;
+		state->records.Add(std::move(records));
+		DUCKDB_LOG_DEBUG(context, "QueryCDXAPI returned %lu records +%.0fms", (unsigned long)state->records.Size(),
 		                 ElapsedMs());
 	}
 
+	// Response scans use small ranges so WARC fetching/decoding spreads over threads
+	state->ranges.Initialize(state->records.Size(),
+	                         bind_data.fetch_response ? RESPONSE_SCAN_RANGE_SIZE : STANDARD_VECTOR_SIZE);
+
+	// WARC fetches run ahead of the scan threads, at most `prefetch` records beyond the furthest one claimed
+	if (bind_data.fetch_response) {
+		auto records = &state->records;
+		auto options = std::make_shared<WARCFetchOptions>();
+		options->cancelled = state->fetches.CancellationFlag();
+		options->running = state->fetches.RunningTasks();
+		options->timeout_seconds = bind_data.timeout_seconds;
+		options->cache = DiskCache::Get(context, "content");
+		options->max_body_bytes = need_body ? bind_data.max_body_bytes : 0;
+		options->reuse_bodies = reuse_bodies;
+		if (reuse_bodies) {
+			options->bodies = BodyCache::Get(context);
+		}
+		if (options->bodies) {
+			options->body_store = DiskCache::Get(context, "bodies");
+		}
+		options->parse_warc_headers = projects_warc && state->warc_fields[WARC_HEADERS_FIELD];
+		options->parse_http_headers = projects_response && state->response_fields[RESPONSE_HEADERS_FIELD];
+		state->fetches.Initialize(state->records.Size(), bind_data.prefetch,
+		                          [&context, records, options](idx_t begin, idx_t end,
+		                                                       vector<std::future<WARCResponse>> &out) {
+			                          SubmitWARCFetches(context, *records, begin, end, options, out);
+		                          });
+	}
+
 	return std::move(state);
 }
 
-// Scan function for the table function
-static void CommonCrawlScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-	DUCKDB_LOG_DEBUG(context, "CommonCrawlScan called +%.0fms", ElapsedMs());
-	auto &bind_data = data.bind_data->Cast<CommonCrawlBindData>();
-	auto &gstate = data.global_state->Cast<CommonCrawlGlobalState>();
-	DUCKDB_LOG_DEBUG(context, "Have %lu records to process +%.0fms", (unsigned long)gstate.records.size(), ElapsedMs());
+// Init local state function
+static unique_ptr<LocalTableFunctionState> CommonCrawlInitLocal(ExecutionContext &context,
+                                                                TableFunctionInitInput &input,
+                                                                GlobalTableFunctionState *global_state) {
+	return make_uniq<CommonCrawlLocalState>();
+}
 
-	// Pre-fetch WARCs in parallel for this chunk if needed
-	std::vector<WARCResponse> warc_responses;
-	idx_t chunk_size = std::min<idx_t>(STANDARD_VECTOR_SIZE, gstate.records.size() - gstate.current_position);
+// ========================================
+// COLUMN WRITERS
+// ========================================
 
-	if (bind_data.fetch_response && chunk_size > 0) {
-		DUCKDB_LOG_DEBUG(context, "Pre-fetching %lu WARCs in parallel +%.0fms", (unsigned long)chunk_size, ElapsedMs());
-		std::vector<std::future<WARCResponse>> warc_futures;
-		warc_futures.reserve(chunk_size);
+// Each projected column is filled for the whole chunk in one loop (column-major), dispatched once per chunk
 
-		// Start timer for timeout tracking
-		auto fetch_start = std::chrono::steady_clock::now();
-		int timeout = bind_data.timeout_seconds;
+template <class T>
+static void WriteFixedColumn(Vector &vector, const duckdb::vector<T> &column, idx_t begin, idx_t count) {
+	memcpy(FlatVector::GetData<T>(vector), column.data() + begin, count * sizeof(T));
+}
 
-		// Launch parallel WARC fetches
-		for (idx_t i = 0; i < chunk_size; i++) {
-			auto &record = gstate.records[gstate.current_position + i];
-			warc_futures.push_back(std::async(std::launch::async, [&context, record, fetch_start, timeout]() {
-				return FetchWARCResponse(context, record, fetch_start, timeout);
-			}));
-		}
+static void WriteStringColumn(Vector &vector, const CDXStringColumn &column, idx_t begin, idx_t count) {
+	auto data = FlatVector::GetData<string_t>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		data[row] = AddSanitizedString(vector, column.Data(begin + row), column.Length(begin + row));
+	}
+}
 
-		// Collect results
-		warc_responses.reserve(chunk_size);
-		for (auto &future : warc_futures) {
-			warc_responses.push_back(future.get());
-		}
-		DUCKDB_LOG_DEBUG(context, "All %lu WARCs fetched +%.0fms", (unsigned long)chunk_size, ElapsedMs());
+static void WriteConstantStringColumn(Vector &vector, const string &value, idx_t count) {
+	auto data = FlatVector::GetData<string_t>(vector);
+	if (count > 0) {
+		data[0] = StringVector::AddString(vector, value);
 	}
+	for (idx_t row = 1; row < count; row++) {
+		data[row] = data[0];
+	}
+}
 
-	idx_t output_offset = 0;
-	while (gstate.current_position < gstate.records.size() && output_offset < STANDARD_VECTOR_SIZE) {
-		auto &record = gstate.records[gstate.current_position];
+static void WriteWARCVersion(Vector &vector, idx_t row, const WARCResponse &response) {
+	FlatVector::GetData<string_t>(vector)[row] =
+	    AddSanitizedString(vector, response.Ptr(response.warc_version), response.warc_version.length);
+}
 
-		bool row_success = true;
+static void WriteWARCHeaders(Vector &vector, idx_t row, const WARCResponse &response) {
+	WriteHeaderMap(vector, row, response, response.warc_headers);
+}
 
-		// Process each projected column
-		for (idx_t proj_idx = 0; proj_idx < gstate.column_ids.size(); proj_idx++) {
-			auto col_id = gstate.column_ids[proj_idx];
-			string col_name = bind_data.column_names[col_id];
+static void WriteResponseBody(Vector &vector, idx_t row, const WARCResponse &response) {
+	// Referenced in place: the vector keeps the inflated record alive
+	FlatVector::GetData<string_t>(vector)[row] =
+	    AddSharedBlob(vector, response.data, response.Ptr(response.body), response.body.length);
+}
 
-			try {
-				if (col_name == "url") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.url));
-				} else if (col_name == "timestamp") {
-					auto data_ptr = FlatVector::GetData<timestamp_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = ParseCDXTimestamp(record.timestamp);
-				} else if (col_name == "mimetype") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] =
-					    StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.mime_type));
-				} else if (col_name == "statuscode") {
-					auto data_ptr = FlatVector::GetData<int32_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = record.status_code;
-				} else if (col_name == "digest") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] =
-					    StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.digest));
-				} else if (col_name == "filename") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] =
-					    StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.filename));
-				} else if (col_name == "offset") {
-					auto data_ptr = FlatVector::GetData<int64_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = record.offset;
-				} else if (col_name == "length") {
-					auto data_ptr = FlatVector::GetData<int64_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = record.length;
-				} else if (col_name == "crawl_id") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = StringVector::AddString(output.data[proj_idx], record.crawl_id);
-				} else if (col_name == "warc" || col_name == "response") {
-					if (bind_data.fetch_response && !warc_responses.empty()) {
-						WARCResponse &warc_response = warc_responses[output_offset];
-
-						if (col_name == "warc") {
-							// WARC STRUCT with version and headers
-							auto &struct_vector = output.data[proj_idx];
-							auto &struct_children = StructVector::GetEntries(struct_vector);
-
-							// Child 0: version (VARCHAR)
-							auto &version_vector = struct_children[0];
-							auto version_data = FlatVector::GetData<string_t>(*version_vector);
-							version_data[output_offset] =
-							    StringVector::AddString(*version_vector, SanitizeUTF8(warc_response.warc_version));
-
-							// Child 1: headers (MAP)
-							auto &headers_map = struct_children[1];
-							auto &map_keys = MapVector::GetKeys(*headers_map);
-							auto &map_values = MapVector::GetValues(*headers_map);
-
-							idx_t map_offset = ListVector::GetListSize(*headers_map);
-							idx_t new_size = map_offset + warc_response.warc_headers.size();
-							ListVector::Reserve(*headers_map, new_size);
-
-							auto key_data = FlatVector::GetData<string_t>(map_keys);
-							auto value_data = FlatVector::GetData<string_t>(map_values);
-
-							for (const auto &header : warc_response.warc_headers) {
-								key_data[map_offset] = StringVector::AddString(map_keys, header.first);
-								value_data[map_offset] =
-								    StringVector::AddString(map_values, SanitizeUTF8(header.second));
-								map_offset++;
-							}
+static void WriteResponseHeaders(Vector &vector, idx_t row, const WARCResponse &response) {
+	WriteHeaderMap(vector, row, response, response.http_headers);
+}
 
-							auto map_data = FlatVector::GetData<list_entry_t>(*headers_map);
-							map_data[output_offset].offset = ListVector::GetListSize(*headers_map);
-							map_data[output_offset].length = warc_response.warc_headers.size();
-							ListVector::SetListSize(*headers_map, map_offset);
-
-						} else if (col_name == "response") {
-							// Response STRUCT with body, headers, http_version
-							auto &struct_vector = output.data[proj_idx];
-							auto &struct_children = StructVector::GetEntries(struct_vector);
-
-							// Child 0: body (BLOB)
-							auto &body_vector = struct_children[0];
-							auto body_data = FlatVector::GetData<string_t>(*body_vector);
-							body_data[output_offset] = StringVector::AddStringOrBlob(*body_vector, warc_response.body);
-
-							// Child 1: headers (MAP)
-							auto &headers_map = struct_children[1];
-							auto &map_keys = MapVector::GetKeys(*headers_map);
-							auto &map_values = MapVector::GetValues(*headers_map);
-
-							idx_t map_offset = ListVector::GetListSize(*headers_map);
-							idx_t new_size = map_offset + warc_response.http_headers.size();
-							ListVector::Reserve(*headers_map, new_size);
-
-							auto key_data = FlatVector::GetData<string_t>(map_keys);
-							auto value_data = FlatVector::GetData<string_t>(map_values);
-
-							for (const auto &header : warc_response.http_headers) {
-								key_data[map_offset] = StringVector::AddString(map_keys, header.first);
-								value_data[map_offset] =
-								    StringVector::AddString(map_values, SanitizeUTF8(header.second));
-								map_offset++;
-							}
+static void WriteResponseHTTPVersion(Vector &vector, idx_t row, const WARCResponse &response) {
+	FlatVector::GetData<string_t>(vector)[row] =
+	    AddSanitizedString(vector, response.Ptr(response.http_version), response.http_version.length);
+}
 
-							auto map_data = FlatVector::GetData<list_entry_t>(*headers_map);
-							map_data[output_offset].offset = ListVector::GetListSize(*headers_map);
-							map_data[output_offset].length = warc_response.http_headers.size();
-							ListVector::SetListSize(*headers_map, map_offset);
+static void WriteResponseError(Vector &vector, idx_t row, const WARCResponse &response) {
+	// error is NULL on success
+	if (response.error.empty()) {
+		SetUnusedStructField(vector, row);
+		return;
+	}
+	FlatVector::GetData<string_t>(vector)[row] = AddSanitizedString(vector, response.error);
+}
 
-							// Child 2: http_version (VARCHAR)
-							auto &version_vector = struct_children[2];
-							auto version_data = FlatVector::GetData<string_t>(*version_vector);
-							version_data[output_offset] =
-							    StringVector::AddString(*version_vector, SanitizeUTF8(warc_response.http_version));
-						}
-					} else {
-						FlatVector::SetNull(output.data[proj_idx], output_offset, true);
-					}
-				} else if (col_name == "cdx_url") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = StringVector::AddString(output.data[proj_idx], bind_data.cdx_url);
+static void WriteResponseTruncated(Vector &vector, idx_t row, const WARCResponse &response) {
+	FlatVector::GetData<bool>(vector)[row] = response.body_truncated;
+}
+
+typedef void (*WARCFieldWriter)(Vector &vector, idx_t row, const WARCResponse &response);
+
+// Writers of the warc and response STRUCT children, in field order
+static const WARCFieldWriter WARC_FIELD_WRITERS[WARC_STRUCT_FIELDS] = {WriteWARCVersion, WriteWARCHeaders};
+static const WARCFieldWriter RESPONSE_FIELD_WRITERS[RESPONSE_STRUCT_FIELDS] = {
+    WriteResponseBody, WriteResponseHeaders, WriteResponseHTTPVersion, WriteResponseError, WriteResponseTruncated};
+
+// Fill one child of the warc/response STRUCT for the chunk; children the query does not read stay NULL.
+// A row whose value cannot be built is logged and dropped from the chunk.
+static void WriteStructField(ClientContext &context, Vector &struct_vector, idx_t field_idx, bool used,
+                             WARCFieldWriter writer, const vector<WARCResponse> &responses, idx_t count,
+                             vector<bool> &failed_rows) {
+	auto &child = *StructVector::GetEntries(struct_vector)[field_idx];
+	for (idx_t row = 0; row < count; row++) {
+		if (!used) {
+			SetUnusedStructField(child, row);
+			continue;
+		}
+		try {
+			writer(child, row, responses[row]);
+		} catch (const std::exception &ex) {
+			DUCKDB_LOG_ERROR(context, "Failed to write field %lu of row %lu: %s", (unsigned long)field_idx,
+			                 (unsigned long)row, ex.what());
+			SetUnusedStructField(child, row);
+			failed_rows[row] = true;
+		}
+	}
+}
+
+// Emit up to one chunk of rows from the thread's current record range
+static idx_t CommonCrawlScanRange(ClientContext &context, const CommonCrawlBindData &bind_data,
+                                  CommonCrawlGlobalState &gstate, CommonCrawlLocalState &lstate, DataChunk &output) {
+	DUCKDB_LOG_DEBUG(context, "Scanning records %lu-%lu (batch %lu) +%.0fms", (unsigned long)lstate.position,
+	                 (unsigned long)lstate.range_end, (unsigned long)lstate.batch_index, ElapsedMs());
+
+	vector<WARCResponse> warc_responses;
+	idx_t chunk_size = std::min<idx_t>(STANDARD_VECTOR_SIZE, lstate.range_end - lstate.position);
+
+	// A chunk never spans two crawls' batches
+	idx_t begin = lstate.position;
+	auto &batch = gstate.records.Locate(begin);
+	chunk_size = MinValue<idx_t>(chunk_size, batch.Size() - begin);
+
+	if (bind_data.fetch_response && chunk_size > 0) {
+		// Emit rows as soon as their WARCs arrive: wait for the next record only, then take
+		// every following record whose fetch already completed (no barrier on the whole chunk)
+		lstate.fetches.TakeReady(warc_responses, chunk_size);
+		chunk_size = warc_responses.size();
+		DUCKDB_LOG_DEBUG(context, "%lu WARCs ready +%.0fms", (unsigned long)chunk_size, ElapsedMs());
+	}
+
+	bool have_responses = bind_data.fetch_response && !warc_responses.empty();
+	vector<bool> failed_rows(chunk_size, false);
+	for (idx_t proj_idx = 0; proj_idx < gstate.columns.size(); proj_idx++) {
+		auto &column_vector = output.data[proj_idx];
+		switch (gstate.columns[proj_idx]) {
+		case CommonCrawlColumn::URL:
+			WriteStringColumn(column_vector, batch.url, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::TIMESTAMP:
+			WriteFixedColumn(column_vector, batch.timestamp, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::MIMETYPE:
+			WriteStringColumn(column_vector, batch.mime_type, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::STATUSCODE:
+			WriteFixedColumn(column_vector, batch.status_code, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::DIGEST:
+			WriteStringColumn(column_vector, batch.digest, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::FILENAME:
+			WriteStringColumn(column_vector, batch.filename, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::OFFSET:
+			WriteFixedColumn(column_vector, batch.offset, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::LENGTH:
+			WriteFixedColumn(column_vector, batch.length, begin, chunk_size);
+			break;
+		case CommonCrawlColumn::CRAWL_ID:
+			WriteConstantStringColumn(column_vector, batch.crawl_id, chunk_size);
+			break;
+		case CommonCrawlColumn::WARC:
+		case CommonCrawlColumn::RESPONSE: {
+			if (!have_responses) {
+				for (idx_t row = 0; row < chunk_size; row++) {
+					FlatVector::SetNull(column_vector, row, true);
 				}
-			} catch (const std::exception &ex) {
-				DUCKDB_LOG_ERROR(context, "Failed to process column %s for row %lu: %s", col_name.c_str(),
-				                 (unsigned long)gstate.current_position, ex.what());
-				row_success = false;
 				break;
 			}
+			bool is_warc = gstate.columns[proj_idx] == CommonCrawlColumn::WARC;
+			auto &used_fields = is_warc ? gstate.warc_fields : gstate.response_fields;
+			auto writers = is_warc ? WARC_FIELD_WRITERS : RESPONSE_FIELD_WRITERS;
+			for (idx_t field_idx = 0; field_idx < used_fields.size(); field_idx++) {
+				WriteStructField(context, column_vector, field_idx, used_fields[field_idx], writers[field_idx],
+				                 warc_responses, chunk_size, failed_rows);
+			}
+			break;
+		}
+		case CommonCrawlColumn::CDX_URL:
+			WriteConstantStringColumn(column_vector, batch.index_url, chunk_size);
+			break;
+		case CommonCrawlColumn::OTHER:
+			break;
+		}
+	}
+	lstate.position += chunk_size;
+
+	// Drop rows that failed to convert
+	idx_t output_count = 0;
+	SelectionVector keep(STANDARD_VECTOR_SIZE);
+	for (idx_t row = 0; row < chunk_size; row++) {
+		if (!failed_rows[row]) {
+			keep.set_index(output_count++, row);
 		}
+	}
+	if (output_count > 0 && output_count < chunk_size) {
+		output.Slice(keep, output_count);
+	}
+	return output_count;
+}
+
+// Append the next crawl's records once all ranges so far are claimed; false when there are no more.
+// seen_rows is the record count the caller saw before it failed to claim a range.
+static bool LoadNextCrawl(CommonCrawlGlobalState &gstate, idx_t seen_rows) {
+	if (!gstate.crawls) {
+		return false;
+	}
+	std::lock_guard<std::mutex> guard(gstate.crawl_lock);
+	if (gstate.records.Size() != seen_rows) {
+		// Another thread appended a crawl meanwhile
+		return true;
+	}
+	CDXRecordBatch batch;
+	if (!gstate.crawls->Next(batch)) {
+		return false;
+	}
+	gstate.records.Add(std::move(batch));
+	gstate.ranges.Extend(gstate.records.Size());
+	gstate.fetches.Extend(gstate.records.Size());
+	return true;
+}
+
+// Scan function for the table function
+static void CommonCrawlScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	DUCKDB_LOG_DEBUG(context, "CommonCrawlScan called +%.0fms", ElapsedMs());
+	auto &bind_data = data.bind_data->Cast<CommonCrawlBindData>();
+	auto &gstate = data.global_state->Cast<CommonCrawlGlobalState>();
+	auto &lstate = data.local_state->Cast<CommonCrawlLocalState>();
 
-		if (row_success) {
-			output_offset++;
+	idx_t output_offset = 0;
+	// Keep going until we emit rows: an empty chunk tells DuckDB this thread is done
+	while (output_offset == 0) {
+		// Claim the next record range once the current one is exhausted
+		if (lstate.position >= lstate.range_end) {
+			auto seen_rows = gstate.records.Size();
+			if (!gstate.ranges.Next(lstate.position, lstate.range_end, lstate.batch_index)) {
+				if (LoadNextCrawl(gstate, seen_rows)) {
+					continue;
+				}
+				break;
+			}
+			if (bind_data.fetch_response) {
+				// Taking the range's fetches also tops up the prefetch window beyond it
+				lstate.fetches.cancelled = gstate.fetches.CancellationFlag();
+				for (idx_t i = lstate.position; i < lstate.range_end; i++) {
+					lstate.fetches.futures.push_back(gstate.fetches.Take(i));
+				}
+			}
 		}
-		gstate.current_position++;
+		output_offset = CommonCrawlScanRange(context, bind_data, gstate, lstate, output);
 	}
 
 	output.SetCardinality(output_offset);
 }
 
+// Report the record range being emitted as batch index (lets DuckDB preserve insertion order across threads)
+static OperatorPartitionData CommonCrawlGetPartitionData(ClientContext &context,
+                                                         TableFunctionGetPartitionInput &input) {
+	if (input.partition_info.RequiresPartitionColumns()) {
+		throw InternalException("common_crawl_index does not support partition columns");
+	}
+	auto &lstate = input.local_state->Cast<CommonCrawlLocalState>();
+	return OperatorPartitionData(lstate.batch_index);
+}
+
 // ========================================
 // FILTER PUSHDOWN
 // ========================================
@@ -886,6 +1776,103 @@ static bool TryHandleInExpression(ClientContext &context, CommonCrawlBindData &b
 }
 
 // Filter pushdown function to handle WHERE clauses
+// Only the first url predicate pushed down becomes the scan's URL pattern(s); later ones stay DuckDB filters on
+// its result
+static bool CanPushUrlPattern(const CommonCrawlBindData &bind_data) {
+	return (bind_data.url_filter == "*" || bind_data.url_filter.empty()) && bind_data.url_filters.empty();
+}
+
+// CDX URL pattern of a url predicate the index answers by itself: url = / LIKE / prefix() / suffix() / contains()
+// against a constant
+static bool TryGetUrlPattern(const Expression &expr, string &pattern) {
+	const Expression *column;
+	const Expression *value;
+	string function_name;
+	if (expr.GetExpressionClass() == ExpressionClass::BOUND_COMPARISON && expr.type == ExpressionType::COMPARE_EQUAL) {
+		auto &comparison = expr.Cast<BoundComparisonExpression>();
+		column = comparison.left.get();
+		value = comparison.right.get();
+		function_name = "=";
+	} else if (expr.GetExpressionClass() == ExpressionClass::BOUND_FUNCTION) {
+		auto &func = expr.Cast<BoundFunctionExpression>();
+		if (func.children.size() < 2) {
+			return false;
+		}
+		column = func.children[0].get();
+		value = func.children[1].get();
+		function_name = func.function.name;
+	} else {
+		return false;
+	}
+	if (column->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF ||
+	    column->Cast<BoundColumnRefExpression>().GetName() != "url" ||
+	    value->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+		return false;
+	}
+	auto &constant = value->Cast<BoundConstantExpression>().value;
+	if (constant.type().id() != LogicalTypeId::VARCHAR || constant.IsNull()) {
+		return false;
+	}
+	auto text = constant.ToString();
+	if (function_name == "=") {
+		// An exact match: % and _ are literal URL characters here, not wildcards
+		pattern = text;
+	} else if (function_name == "like" || function_name == "~~") {
+		pattern = ConvertSQLWildcardsToCDX(text);
+	} else if (function_name == "prefix") {
+		pattern = text + "*";
+	} else if (function_name == "suffix") {
+		pattern = "*" + text;
+	} else if (function_name == "contains") {
+		pattern = "*" + text + "*";
+	} else {
+		return false;
+	}
+	return true;
+}
+
+// url IN ('a', 'b', ...) or an OR of url predicates TryGetUrlPattern understands: one CDX pattern per alternative,
+// duplicates dropped. IN literals are exact URLs and are passed through as they are. False when any alternative is
+// something else.
+static bool TryGetUrlPatterns(const Expression &expr, vector<string> &patterns) {
+	vector<string> alternatives;
+	if (expr.GetExpressionClass() == ExpressionClass::BOUND_OPERATOR && expr.type == ExpressionType::COMPARE_IN) {
+		auto &op = expr.Cast<BoundOperatorExpression>();
+		if (op.children.size() < 2 || op.children[0]->GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF ||
+		    op.children[0]->Cast<BoundColumnRefExpression>().GetName() != "url") {
+			return false;
+		}
+		for (idx_t j = 1; j < op.children.size(); j++) {
+			if (op.children[j]->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+				return false;
+			}
+			auto &constant = op.children[j]->Cast<BoundConstantExpression>().value;
+			if (constant.type().id() != LogicalTypeId::VARCHAR || constant.IsNull()) {
+				return false;
+			}
+			alternatives.push_back(constant.ToString());
+		}
+	} else if (expr.GetExpressionClass() == ExpressionClass::BOUND_CONJUNCTION &&
+	           expr.type == ExpressionType::CONJUNCTION_OR) {
+		for (auto &child : expr.Cast<BoundConjunctionExpression>().children) {
+			string pattern;
+			if (!TryGetUrlPattern(*child, pattern)) {
+				return false;
+			}
+			alternatives.push_back(pattern);
+		}
+	} else {
+		return false;
+	}
+	std::unordered_set<string> seen;
+	for (auto &pattern : alternatives) {
+		if (seen.insert(pattern).second) {
+			patterns.push_back(pattern);
+		}
+	}
+	return !patterns.empty();
+}
+
 static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
                                              vector<unique_ptr<Expression>> &filters) {
 	DUCKDB_LOG_DEBUG(context, "CommonCrawlPushdownComplexFilter called with %lu filters +%.0fms",
@@ -905,6 +1892,19 @@ static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet
 		auto &filter = filters[i];
 		DUCKDB_LOG_DEBUG(context, "Filter %lu: class=%d", (unsigned long)i, (int)filter->GetExpressionClass());
 
+		// url IN (...) / OR of url LIKEs: one index query per pattern and crawl
+		vector<string> url_patterns;
+		if (CanPushUrlPattern(bind_data) && TryGetUrlPatterns(*filter, url_patterns)) {
+			DUCKDB_LOG_DEBUG(context, "URL patterns: %s", StringUtil::Join(url_patterns, ", ").c_str());
+			if (url_patterns.size() == 1) {
+				bind_data.url_filter = url_patterns[0];
+			} else {
+				bind_data.url_filters = std::move(url_patterns);
+			}
+			filters_to_remove.push_back(i);
+			continue;
+		}
+
 		// Handle BOUND_OPERATOR for IN clauses (e.g., crawl_id IN ('id1', 'id2'))
 		// DuckDB represents IN as a BOUND_OPERATOR with children: [column, value1, value2, ...]
 		if (filter->GetExpressionClass() == ExpressionClass::BOUND_OPERATOR) {
@@ -1022,7 +2022,8 @@ static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet
 					auto &constant = func.children[1]->Cast<BoundConstantExpression>();
 					string column_name = col_ref.GetName();
 
-					if (column_name == "url" && constant.value.type().id() == LogicalTypeId::VARCHAR) {
+					if (column_name == "url" && CanPushUrlPattern(bind_data) &&
+					    constant.value.type().id() == LogicalTypeId::VARCHAR) {
 						string suffix_string = constant.value.ToString();
 						// Convert to CDX wildcard pattern: *suffix_string
 						bind_data.url_filter = "*" + suffix_string;
@@ -1046,7 +2047,7 @@ static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet
 
 					if (constant.value.type().id() == LogicalTypeId::VARCHAR) {
 						string prefix_string = constant.value.ToString();
-						if (column_name == "url") {
+						if (column_name == "url" && CanPushUrlPattern(bind_data)) {
 							// Convert to CDX wildcard pattern: prefix_string*
 							bind_data.url_filter = prefix_string + "*";
 							DUCKDB_LOG_DEBUG(context, "PREFIX URL filter: '%s' -> '%s'", prefix_string.c_str(),
@@ -1076,7 +2077,8 @@ static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet
 					auto &constant = func.children[1]->Cast<BoundConstantExpression>();
 					string column_name = col_ref.GetName();
 
-					if (column_name == "url" && constant.value.type().id() == LogicalTypeId::VARCHAR) {
+					if (column_name == "url" && CanPushUrlPattern(bind_data) &&
+					    constant.value.type().id() == LogicalTypeId::VARCHAR) {
 						string search_string = constant.value.ToString();
 						// Convert to CDX wildcard pattern: *search_string*
 						bind_data.url_filter = "*" + search_string + "*";
@@ -1101,7 +2103,7 @@ static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet
 					if (constant.value.type().id() == LogicalTypeId::VARCHAR) {
 						string original_pattern = constant.value.ToString();
 
-						if (column_name == "url") {
+						if (column_name == "url" && CanPushUrlPattern(bind_data)) {
 							// Convert SQL LIKE wildcards (%) to CDX API wildcards (*)
 							bind_data.url_filter = ConvertSQLWildcardsToCDX(original_pattern);
 							DUCKDB_LOG_DEBUG(context, "LIKE URL filter: '%s' -> '%s'", original_pattern.c_str(),
@@ -1417,12 +2419,11 @@ static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet
 		}
 
 		// Handle URL filtering (special case - uses url parameter)
-		if (column_name == "url" && constant.value.type().id() == LogicalTypeId::VARCHAR) {
-			string original_pattern = constant.value.ToString();
-			// Convert SQL LIKE wildcards (%) to CDX API wildcards (*)
-			bind_data.url_filter = ConvertSQLWildcardsToCDX(original_pattern);
-			DUCKDB_LOG_DEBUG(context, "URL filter: '%s' -> '%s'", original_pattern.c_str(),
-			                 bind_data.url_filter.c_str());
+		if (column_name == "url" && CanPushUrlPattern(bind_data) &&
+		    constant.value.type().id() == LogicalTypeId::VARCHAR) {
+			// url = is an exact match: % and _ are literal URL characters, not wildcards
+			bind_data.url_filter = constant.value.ToString();
+			DUCKDB_LOG_DEBUG(context, "URL filter: '%s'", bind_data.url_filter.c_str());
 			filters_to_remove.push_back(i);
 		}
 		// Handle crawl_id filtering (sets the index_name to use)
@@ -1463,6 +2464,9 @@ static void CommonCrawlPushdownComplexFilter(ClientContext &context, LogicalGet
 static unique_ptr<NodeStatistics> CommonCrawlCardinality(ClientContext &context, const FunctionData *bind_data_p) {
 	auto &bind_data = bind_data_p->Cast<CommonCrawlBindData>();
 	// Return the max results as an estimate - this helps DuckDB optimize the query plan
+	if (bind_data.max_results == CDX_NO_LIMIT) {
+		return make_uniq<NodeStatistics>();
+	}
 	return make_uniq<NodeStatistics>(bind_data.max_results);
 }
 
@@ -1507,11 +2511,9 @@ void OptimizeCommonCrawlLimitPushdown(unique_ptr<LogicalOperator> &op) {
 		auto &bind_data = get.bind_data->Cast<CommonCrawlBindData>();
 		if (limit.limit_val.Type() == LimitNodeType::CONSTANT_VALUE) {
 			auto limit_value = limit.limit_val.GetConstantValue();
-			// For common_crawl with multiple crawl_ids, divide limit across crawl_ids
-			if (!bind_data.crawl_ids.empty()) {
-				limit_value = (limit_value + bind_data.crawl_ids.size() - 1) / bind_data.crawl_ids.size();
-			}
+			// With several crawls or URL patterns the LIMIT caps the rows over all of them (see MultiCrawlScheduler)
 			bind_data.max_results = limit_value;
+			bind_data.total_limit = limit_value;
 
 			// Remove the LIMIT node from the plan since we've pushed it down
 			op = std::move(op->children[0]);
@@ -1538,8 +2540,9 @@ void RegisterCommonCrawlFunction(ExtensionLoader &loader) {
 	// - Optional max_results parameter controls CDX API result size (default: 100)
 	TableFunctionSet common_crawl_set("common_crawl_index");
 
-	auto func = TableFunction({}, CommonCrawlScan, CommonCrawlBind, CommonCrawlInitGlobal);
+	auto func = TableFunction({}, CommonCrawlScan, CommonCrawlBind, CommonCrawlInitGlobal, CommonCrawlInitLocal);
 	func.cardinality = CommonCrawlCardinality;
+	func.get_partition_data = CommonCrawlGetPartitionData;
 	func.pushdown_complex_filter = CommonCrawlPushdownComplexFilter;
 	func.projection_pushdown = true;
 
@@ -1547,6 +2550,10 @@ void RegisterCommonCrawlFunction(ExtensionLoader &loader) {
 	func.named_parameters["max_results"] = LogicalType::BIGINT;
 	func.named_parameters["debug"] = LogicalType::BOOLEAN;
 	func.named_parameters["timeout"] = LogicalType::BIGINT;
+	func.named_parameters["prefetch"] = LogicalType::BIGINT;
+	func.named_parameters["source"] = LogicalType::VARCHAR;
+	func.named_parameters["index_path"] = LogicalType::VARCHAR;
+	func.named_parameters["max_body_bytes"] = LogicalType::BIGINT;
 
 	common_crawl_set.AddFunction(func);
 
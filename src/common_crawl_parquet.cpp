@@ -0,0 +1,200 @@
+#include "web_archive_utils.hpp"
+#include "web_archive_cache.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/connection.hpp"
+
+namespace duckdb {
+
+// ========================================
+// PREDICATE TRANSLATION
+// ========================================
+
+static string SQLString(const string &value) {
+	return Value(value).ToSQLString();
+}
+
+// cc-index column holding a CDX API field
+static string ParquetColumnForCDXField(const string &field) {
+	if (field == "url") {
+		return "url";
+	} else if (field == "urlkey") {
+		return "url_surtkey";
+	} else if (field == "mime") {
+		return "content_mime_type";
+	} else if (field == "status") {
+		return "fetch_status";
+	} else if (field == "digest") {
+		return "content_digest";
+	} else if (field == "filename") {
+		return "warc_filename";
+	} else if (field == "offset") {
+		return "warc_record_offset";
+	} else if (field == "length") {
+		return "warc_record_length";
+	} else if (field == "timestamp") {
+		return "strftime(CAST(fetch_time AS TIMESTAMP), '%Y%m%d%H%M%S')";
+	}
+	throw InvalidInputException("CDX filter field '%s' has no cc-index column", field);
+}
+
+static bool IsIntegerLiteral(const string &value) {
+	if (value.empty()) {
+		return false;
+	}
+	for (auto c : value) {
+		if (c < '0' || c > '9') {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Exact matches on numeric columns stay typed so the Parquet reader can use them for row group pruning
+static string CDXFilterToPredicate(const string &filter_str) {
+	auto filter = ParseCDXFilter(filter_str);
+	auto column = ParquetColumnForCDXField(filter.field);
+	bool numeric = filter.field == "status" || filter.field == "offset" || filter.field == "length";
+	string predicate;
+	if (filter.exact && numeric && IsIntegerLiteral(filter.value)) {
+		predicate = column + " = " + filter.value;
+	} else if (filter.exact) {
+		predicate = "CAST(" + column + " AS VARCHAR) = " + SQLString(filter.value);
+	} else {
+		predicate = "regexp_matches(CAST(" + column + " AS VARCHAR), " + SQLString(filter.value) + ")";
+	}
+	// NULL columns never match a CDX filter, negated or not
+	return filter.negated ? "NOT COALESCE(" + predicate + ", true)" : "COALESCE(" + predicate + ", false)";
+}
+
+static string SurtRangeToPredicate(const string &url_pattern) {
+	string surt_prefix;
+	SurtMatch match;
+	ParseSurtRange(url_pattern, surt_prefix, match);
+	switch (match) {
+	case SurtMatch::EXACT:
+		return "url_surtkey = " + SQLString(surt_prefix);
+	case SurtMatch::PREFIX:
+		return "starts_with(url_surtkey, " + SQLString(surt_prefix) + ")";
+	case SurtMatch::DOMAIN:
+		return "(starts_with(url_surtkey, " + SQLString(surt_prefix + ")") + ") OR starts_with(url_surtkey, " +
+		       SQLString(surt_prefix + ",") + "))";
+	}
+	return "true";
+}
+
+// ========================================
+// RESULT CONVERSION
+// ========================================
+
+// Copy a VARCHAR result column into a batch column (NULL becomes the empty string)
+static void AppendStringColumn(CDXStringColumn &column, Vector &vector, idx_t count) {
+	auto &validity = FlatVector::Validity(vector);
+	auto data = FlatVector::GetData<string_t>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		if (validity.RowIsValid(row)) {
+			column.Append(data[row].GetData(), data[row].GetSize());
+		} else {
+			column.Append("", 0);
+		}
+	}
+}
+
+// Copy a numeric result column into a batch column (NULL becomes 0)
+template <class T>
+static void AppendFixedColumn(vector<T> &column, Vector &vector, idx_t count) {
+	auto &validity = FlatVector::Validity(vector);
+	auto data = FlatVector::GetData<T>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		column.push_back(validity.RowIsValid(row) ? data[row] : T(0));
+	}
+}
+
+// ========================================
+// PARQUET QUERY
+// ========================================
+
+CDXRecordBatch QueryParquetIndex(ClientContext &context, const string &index_path, const string &crawl_id,
+                                 const string &url_pattern, const vector<string> &cdx_filters, idx_t max_results,
+                                 timestamp_t ts_from, timestamp_t ts_to, string &out_index_url) {
+	DUCKDB_LOG_DEBUG(context, "QueryParquetIndex started +%.0fms", ElapsedMs());
+	string path = index_path;
+	while (!path.empty() && path.back() == '/') {
+		path.pop_back();
+	}
+	// Only the crawl's WARC subset is listed and scanned; hive_partitioning exposes crawl/subset as columns
+	string files = path + "/crawl=" + crawl_id + "/subset=warc/*.parquet";
+
+	vector<string> predicates;
+	predicates.push_back(SurtRangeToPredicate(url_pattern));
+	if (ts_from.value != 0) {
+		predicates.push_back("CAST(fetch_time AS TIMESTAMP) >= " + SQLString(Timestamp::ToString(ts_from)));
+	}
+	if (ts_to.value != 0) {
+		predicates.push_back("CAST(fetch_time AS TIMESTAMP) <= " + SQLString(Timestamp::ToString(ts_to)));
+	}
+	for (auto &filter : cdx_filters) {
+		predicates.push_back(CDXFilterToPredicate(filter));
+	}
+
+	string sql = "SELECT CAST(url AS VARCHAR), CAST(fetch_time AS TIMESTAMP), CAST(content_mime_type AS VARCHAR), "
+	             "CAST(fetch_status AS INTEGER), CAST(content_digest AS VARCHAR), CAST(warc_filename AS VARCHAR), "
+	             "CAST(warc_record_offset AS BIGINT), CAST(warc_record_length AS BIGINT) FROM read_parquet(" +
+	             SQLString(files) + ", hive_partitioning = true) WHERE " + StringUtil::Join(predicates, " AND ");
+	if (max_results != CDX_NO_LIMIT) {
+		sql += " LIMIT " + to_string(max_results);
+	}
+	out_index_url = sql;
+	DUCKDB_LOG_DEBUG(context, "cc-index query: %s +%.0fms", sql.c_str(), ElapsedMs());
+
+	// Indexed crawls never change, so cached lookups never expire and a remote cc-index is only listed once
+	auto cdx_cache = DiskCache::Get(context, "cdx");
+	auto cache_key = "parquet " + sql;
+	string cached;
+	if (cdx_cache && cdx_cache->Read(cache_key, cached)) {
+		CDXRecordBatch records;
+		records.crawl_id = crawl_id;
+		if (DeserializeCDXRecords(cached, records)) {
+			DUCKDB_LOG_DEBUG(context, "cc-index cache hit: %lu records +%.0fms", (unsigned long)records.Size(),
+			                 ElapsedMs());
+			return records;
+		}
+	}
+
+	// Separate connection: the scan runs as its own query, in parallel, with DuckDB's Parquet reader
+	Connection con(*context.db);
+	auto result = con.Query(sql);
+	if (result->HasError()) {
+		throw IOException("Failed to query cc-index at %s: %s", files, result->GetError());
+	}
+
+	// Result chunks are copied column by column straight into the batch
+	CDXRecordBatch records;
+	records.crawl_id = crawl_id;
+	while (true) {
+		auto chunk = result->Fetch();
+		if (!chunk || chunk->size() == 0) {
+			break;
+		}
+		chunk->Flatten();
+		auto count = chunk->size();
+		AppendStringColumn(records.url, chunk->data[0], count);
+		AppendFixedColumn(records.timestamp, chunk->data[1], count);
+		AppendStringColumn(records.mime_type, chunk->data[2], count);
+		AppendFixedColumn(records.status_code, chunk->data[3], count);
+		AppendStringColumn(records.digest, chunk->data[4], count);
+		AppendStringColumn(records.filename, chunk->data[5], count);
+		AppendFixedColumn(records.offset, chunk->data[6], count);
+		AppendFixedColumn(records.length, chunk->data[7], count);
+	}
+	DUCKDB_LOG_DEBUG(context, "QueryParquetIndex returned %lu records +%.0fms", (unsigned long)records.Size(),
+	                 ElapsedMs());
+	if (cdx_cache) {
+		auto encoded = SerializeCDXRecords(records);
+		cdx_cache->Write(cache_key, encoded.data(), encoded.size());
+	}
+	return records;
+}
+
+} // namespace duckdb
@@ -0,0 +1,399 @@
+#include "web_archive_utils.hpp"
+#include "web_archive_fetch.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "re2/re2.h"
+
+#include <algorithm>
+
+namespace duckdb {
+
+// ========================================
+// SURT KEYS
+// ========================================
+
+string UrlToSurt(const string &url) {
+	// Strip scheme
+	idx_t start = url.find("://");
+	start = start == string::npos ? 0 : start + 3;
+	idx_t host_end = url.find_first_of("/?#", start);
+	if (host_end == string::npos) {
+		host_end = url.size();
+	}
+	string host = StringUtil::Lower(url.substr(start, host_end - start));
+	// Drop the port and a leading www. - both are ignored by the index
+	auto port = host.find(':');
+	if (port != string::npos) {
+		host = host.substr(0, port);
+	}
+	if (StringUtil::StartsWith(host, "www.")) {
+		host = host.substr(4);
+	}
+
+	// Reverse the host labels: www.example.com -> com,example
+	auto labels = StringUtil::Split(host, '.');
+	string surt;
+	for (idx_t i = labels.size(); i > 0; i--) {
+		if (!surt.empty()) {
+			surt += ",";
+		}
+		surt += labels[i - 1];
+	}
+	string path = host_end < url.size() ? url.substr(host_end) : "/";
+	if (path[0] != '/') {
+		path = "/" + path;
+	}
+	return surt + ")" + StringUtil::Lower(path);
+}
+
+void ParseSurtRange(const string &url_pattern, string &surt_prefix, SurtMatch &match) {
+	string pattern = url_pattern;
+	auto scheme = pattern.find("://");
+	if (scheme != string::npos) {
+		pattern = pattern.substr(scheme + 3);
+	}
+
+	if (StringUtil::StartsWith(pattern, "*.")) {
+		// Domain match: *.example.com, *.example.com/* or *.example.com*
+		string host = pattern.substr(2);
+		while (!host.empty() && (host.back() == '*' || host.back() == '/')) {
+			host.pop_back();
+		}
+		if (host.empty() || host.find_first_of("*/?") != string::npos) {
+			throw InvalidInputException("common_crawl_index index lookups only support domain filters of the "
+			                            "form '*.example.com' (got '%s')",
+			                            url_pattern);
+		}
+		auto surt = UrlToSurt(host);
+		surt_prefix = surt.substr(0, surt.find(')'));
+		match = SurtMatch::DOMAIN;
+		return;
+	}
+
+	auto star = pattern.find('*');
+	if (star == string::npos) {
+		surt_prefix = UrlToSurt(pattern);
+		match = SurtMatch::EXACT;
+		return;
+	}
+	if (star != pattern.size() - 1 || pattern.find('/') == string::npos || pattern.find('/') > star) {
+		throw InvalidInputException("common_crawl_index index lookups need a URL filter anchored on a host, "
+		                            "e.g. 'https://example.com/%%' or '%%.example.com/%%' (got '%s')",
+		                            url_pattern);
+	}
+	surt_prefix = UrlToSurt(pattern.substr(0, star));
+	match = SurtMatch::PREFIX;
+}
+
+static bool SurtMatches(const string &key, const string &surt_prefix, SurtMatch match) {
+	switch (match) {
+	case SurtMatch::EXACT:
+		return key == surt_prefix;
+	case SurtMatch::PREFIX:
+		return StringUtil::StartsWith(key, surt_prefix);
+	case SurtMatch::DOMAIN:
+		return StringUtil::StartsWith(key, surt_prefix) && key.size() > surt_prefix.size() &&
+		       (key[surt_prefix.size()] == ')' || key[surt_prefix.size()] == ',');
+	}
+	return false;
+}
+
+// ========================================
+// CLUSTER INDEX
+// ========================================
+
+// One line of cluster.idx: the first key of a gzip block and where the block lives
+struct ZipNumBlock {
+	string key; // "<surt> <timestamp>" of the first record in the block
+	string shard;
+	idx_t offset;
+	idx_t length;
+};
+
+typedef vector<ZipNumBlock> ZipNumClusterIndex;
+
+// Parsed cluster.idx files by path; they never change once a crawl is published
+static std::mutex g_cluster_index_lock;
+static unordered_map<string, shared_ptr<const ZipNumClusterIndex>> g_cluster_indexes;
+
+static shared_ptr<const ZipNumClusterIndex> LoadClusterIndex(ClientContext &context, const string &cluster_path) {
+	{
+		std::lock_guard<std::mutex> guard(g_cluster_index_lock);
+		auto entry = g_cluster_indexes.find(cluster_path);
+		if (entry != g_cluster_indexes.end()) {
+			return entry->second;
+		}
+	}
+
+	DUCKDB_LOG_DEBUG(context, "Loading ZipNum cluster index %s +%.0fms", cluster_path.c_str(), ElapsedMs());
+	auto index = make_shared_ptr<ZipNumClusterIndex>();
+	// Line format: <surt> <timestamp>\t<shard>\t<offset>\t<length>\t<sequence>
+	StreamCDXResponse(context, cluster_path, [&](const char *line, idx_t length) {
+		const char *fields[4];
+		idx_t field_lengths[4];
+		idx_t field = 0;
+		idx_t start = 0;
+		for (idx_t pos = 0; pos <= length && field < 4; pos++) {
+			if (pos == length || line[pos] == '\t') {
+				fields[field] = line + start;
+				field_lengths[field] = pos - start;
+				field++;
+				start = pos + 1;
+			}
+		}
+		if (field < 4) {
+			return true; // Skip malformed lines
+		}
+		ZipNumBlock block;
+		block.key.assign(fields[0], field_lengths[0]);
+		block.shard.assign(fields[1], field_lengths[1]);
+		block.offset = NumericCast<idx_t>(ParseCDXInteger(fields[2], field_lengths[2]));
+		block.length = NumericCast<idx_t>(ParseCDXInteger(fields[3], field_lengths[3]));
+		index->push_back(std::move(block));
+		return true;
+	});
+	DUCKDB_LOG_DEBUG(context, "Loaded %lu ZipNum blocks +%.0fms", (unsigned long)index->size(), ElapsedMs());
+
+	std::lock_guard<std::mutex> guard(g_cluster_index_lock);
+	g_cluster_indexes[cluster_path] = index;
+	return index;
+}
+
+// Blocks that may hold keys starting with surt_prefix: the block before the first key >= prefix
+// (it can end with matching keys) up to the last block whose first key does not sort past the prefix
+static void FindBlockRange(const ZipNumClusterIndex &index, const string &surt_prefix, idx_t &begin, idx_t &end) {
+	auto upper = std::upper_bound(index.begin(), index.end(), surt_prefix,
+	                              [](const string &prefix, const ZipNumBlock &block) { return prefix < block.key; });
+	begin = upper == index.begin() ? 0 : NumericCast<idx_t>(upper - index.begin()) - 1;
+	end = begin;
+	while (end < index.size() && index[end].key.compare(0, surt_prefix.size(), surt_prefix) <= 0) {
+		end++;
+	}
+}
+
+// ========================================
+// LOCAL CDX FILTERS
+// ========================================
+
+CDXFilterSpec ParseCDXFilter(const string &filter) {
+	CDXFilterSpec spec;
+	idx_t pos = 0;
+	if (pos < filter.size() && filter[pos] == '!') {
+		spec.negated = true;
+		pos++;
+	}
+	if (pos < filter.size() && (filter[pos] == '=' || filter[pos] == '~')) {
+		spec.exact = filter[pos] == '=';
+		pos++;
+	}
+	auto colon = filter.find(':', pos);
+	if (colon == string::npos) {
+		throw InvalidInputException("Invalid CDX filter '%s'", filter);
+	}
+	spec.field = filter.substr(pos, colon - pos);
+	spec.value = filter.substr(colon + 1);
+	return spec;
+}
+
+// A CDX filter evaluated on parsed records
+struct LocalCDXFilter {
+	CDXFilterSpec spec;
+	shared_ptr<duckdb_re2::RE2> regex;
+};
+
+static vector<LocalCDXFilter> CompileCDXFilters(const vector<string> &cdx_filters) {
+	vector<LocalCDXFilter> result;
+	for (auto &filter_str : cdx_filters) {
+		LocalCDXFilter filter;
+		filter.spec = ParseCDXFilter(filter_str);
+		if (!filter.spec.exact) {
+			filter.regex = make_shared_ptr<duckdb_re2::RE2>(filter.spec.value);
+			if (!filter.regex->ok()) {
+				throw InvalidInputException("Invalid regex in CDX filter '%s': %s", filter_str, filter.regex->error());
+			}
+		}
+		result.push_back(std::move(filter));
+	}
+	return result;
+}
+
+static string CDXFieldValue(const CDXRecord &record, const string &urlkey, const string &field) {
+	if (field == "urlkey") {
+		return urlkey;
+	} else if (field == "url") {
+		return record.url;
+	} else if (field == "mime") {
+		return record.mime_type;
+	} else if (field == "status") {
+		return to_string(record.status_code);
+	} else if (field == "digest") {
+		return record.digest;
+	} else if (field == "filename") {
+		return record.filename;
+	} else if (field == "timestamp") {
+		return record.timestamp;
+	} else if (field == "offset") {
+		return to_string(record.offset);
+	} else if (field == "length") {
+		return to_string(record.length);
+	}
+	return string();
+}
+
+static bool MatchesCDXFilters(const CDXRecord &record, const string &urlkey, const vector<LocalCDXFilter> &filters) {
+	for (auto &filter : filters) {
+		auto value = CDXFieldValue(record, urlkey, filter.spec.field);
+		bool matches =
+		    filter.spec.exact ? value == filter.spec.value : duckdb_re2::RE2::PartialMatch(value, *filter.regex);
+		if (matches == filter.spec.negated) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// ========================================
+// BLOCK READING
+// ========================================
+
+// Shared by all blocks of one query
+struct ZipNumQuery {
+	string index_dir;
+	string crawl_id;
+	string surt_prefix;
+	SurtMatch match;
+	vector<LocalCDXFilter> filters;
+	timestamp_t ts_from;
+	timestamp_t ts_to;
+	idx_t max_results;
+};
+
+static void ReadFully(FileHandle &handle, char *buffer, idx_t length, idx_t offset) {
+	handle.Seek(offset);
+	idx_t total_read = 0;
+	while (total_read < length) {
+		auto bytes_read = handle.Read(buffer + total_read, length - total_read);
+		if (bytes_read <= 0) {
+			throw IOException("Unexpected end of ZipNum shard at offset %llu", (unsigned long long)(offset + total_read));
+		}
+		total_read += NumericCast<idx_t>(bytes_read);
+	}
+}
+
+// Read and decompress one block, keeping the records that match the query
+static CDXRecordBatch ReadZipNumBlock(ClientContext &context, const ZipNumQuery &query, const ZipNumBlock &block) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto handle = fs.OpenFile(query.index_dir + "/" + block.shard, FileFlags::FILE_FLAGS_READ);
+	auto buffer = unique_ptr<char[]>(new char[block.length]);
+	ReadFully(*handle, buffer.get(), block.length, block.offset);
+
+	string lines = DecompressGzip(buffer.get(), block.length);
+	if (StringUtil::StartsWith(lines, "[Error")) {
+		throw IOException("Failed to decompress ZipNum block %s@%llu: %s", block.shard,
+		                  (unsigned long long)block.offset, lines);
+	}
+
+	// Line format: <surt> <timestamp> {json}
+	CDXRecordBatch records;
+	records.crawl_id = query.crawl_id;
+	CDXRecord record;
+	idx_t pos = 0;
+	while (pos < lines.size() && records.Size() < query.max_results) {
+		auto line_end = lines.find('\n', pos);
+		if (line_end == string::npos) {
+			line_end = lines.size();
+		}
+		const char *line = lines.data() + pos;
+		idx_t length = line_end - pos;
+		pos = line_end + 1;
+
+		auto key_end = static_cast<const char *>(memchr(line, ' ', length));
+		if (!key_end) {
+			continue;
+		}
+		string key(line, key_end - line);
+		if (!SurtMatches(key, query.surt_prefix, query.match)) {
+			continue;
+		}
+		auto json_start = static_cast<const char *>(memchr(line, '{', length));
+		if (!json_start) {
+			continue;
+		}
+		record.Clear();
+		if (!ParseCDXJsonLine(json_start, length - (json_start - line), query.crawl_id, true, record)) {
+			continue;
+		}
+		// Parsed once: the range check and the batch's timestamp column share it
+		auto ts = ParseCDXTimestamp(record.timestamp);
+		if ((query.ts_from.value != 0 && ts < query.ts_from) || (query.ts_to.value != 0 && ts > query.ts_to)) {
+			continue;
+		}
+		if (!MatchesCDXFilters(record, key, query.filters)) {
+			continue;
+		}
+		records.Append(record, ts);
+	}
+	return records;
+}
+
+// ========================================
+// ZIPNUM QUERY
+// ========================================
+
+CDXRecordBatch QueryZipNumIndex(ClientContext &context, const string &index_path, const string &crawl_id,
+                                const string &url_pattern, const vector<string> &cdx_filters, idx_t max_results,
+                                timestamp_t ts_from, timestamp_t ts_to, string &out_index_url) {
+	DUCKDB_LOG_DEBUG(context, "QueryZipNumIndex started +%.0fms", ElapsedMs());
+	auto query = std::make_shared<ZipNumQuery>();
+	query->index_dir = StringUtil::Replace(index_path, "{crawl_id}", crawl_id);
+	while (!query->index_dir.empty() && query->index_dir.back() == '/') {
+		query->index_dir.pop_back();
+	}
+	query->crawl_id = crawl_id;
+	ParseSurtRange(url_pattern, query->surt_prefix, query->match);
+	query->filters = CompileCDXFilters(cdx_filters);
+	query->ts_from = ts_from;
+	query->ts_to = ts_to;
+	query->max_results = max_results;
+
+	string cluster_path = query->index_dir + "/cluster.idx";
+	out_index_url = cluster_path + "?url=" + url_pattern;
+
+	auto index = LoadClusterIndex(context, cluster_path);
+	idx_t begin, end;
+	FindBlockRange(*index, query->surt_prefix, begin, end);
+	DUCKDB_LOG_DEBUG(context, "SURT prefix '%s' spans blocks %lu-%lu +%.0fms", query->surt_prefix.c_str(),
+	                 (unsigned long)begin, (unsigned long)end, ElapsedMs());
+
+	// Blocks are read and decompressed in parallel, a wave of host capacity at a time, and kept in key order
+	string host = GetUrlHost(query->index_dir);
+	if (query->index_dir.find("://") == string::npos) {
+		host = "local";
+	}
+	idx_t wave_size = FetchExecutor::HostConcurrencyLimit(host);
+	CDXRecordBatch records;
+	records.crawl_id = crawl_id;
+	for (idx_t wave_start = begin; wave_start < end && records.Size() < max_results; wave_start += wave_size) {
+		idx_t wave_end = MinValue<idx_t>(wave_start + wave_size, end);
+		vector<std::future<CDXRecordBatch>> blocks;
+		for (idx_t i = wave_start; i < wave_end; i++) {
+			const ZipNumBlock *block = &(*index)[i];
+			blocks.push_back(FetchExecutor::Get().SubmitTask<CDXRecordBatch>(
+			    host, [&context, query, index, block]() { return ReadZipNumBlock(context, *query, *block); }));
+		}
+		// Wait for the whole wave before collecting so no task outlives this call on error
+		for (auto &block : blocks) {
+			block.wait();
+		}
+		for (auto &block : blocks) {
+			auto block_records = block.get();
+			idx_t take = MinValue<idx_t>(block_records.Size(), max_results - records.Size());
+			records.AppendRows(block_records, 0, take);
+		}
+	}
+	DUCKDB_LOG_DEBUG(context, "QueryZipNumIndex returned %lu records +%.0fms", (unsigned long)records.Size(),
+	                 ElapsedMs());
+	return records;
+}
+
+} // namespace duckdb
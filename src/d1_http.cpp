@@ -1,7 +1,10 @@
 #include "d1_extension.hpp"
+#include "single_flight.hpp"
 #include <curl/curl.h>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace duckdb {
 
@@ -412,11 +415,50 @@ static D1QueryResult ParseD1Response(const string &response) {
 	return result;
 }
 
+// ========================================
+// D1 WRITE GENERATIONS
+// ========================================
+
+// Statements that may write, started or finished, per database (account and database id). Shared reads are keyed on
+// it, so a read never joins a request that was sent before a write it should observe.
+static std::mutex d1_write_lock;
+static std::unordered_map<string, uint64_t> d1_write_generations;
+
+static string D1DatabaseKey(const D1Config &config) {
+	return config.account_id + "\n" + config.database_id;
+}
+
+static uint64_t D1WriteGeneration(const D1Config &config) {
+	std::lock_guard<std::mutex> guard(d1_write_lock);
+	return d1_write_generations[D1DatabaseKey(config)];
+}
+
+// Marks a possible write to a database when it starts and again when it ends: reads issued while it runs do not
+// share requests with earlier reads, and reads issued after it do not share requests with those
+class D1WriteScope {
+public:
+	explicit D1WriteScope(const D1Config &config) : database(D1DatabaseKey(config)) {
+		Advance();
+	}
+	~D1WriteScope() {
+		Advance();
+	}
+
+private:
+	void Advance() {
+		std::lock_guard<std::mutex> guard(d1_write_lock);
+		d1_write_generations[database]++;
+	}
+
+	string database;
+};
+
 // ========================================
 // D1 API FUNCTIONS
 // ========================================
 
-D1QueryResult D1ExecuteQuery(const D1Config &config, const string &sql, const vector<string> &params) {
+// Send one statement to the query endpoint
+static D1QueryResult D1PostQuery(const D1Config &config, const string &sql, const vector<string> &params) {
 	// Build JSON request body
 	string body = "{\"sql\":\"" + EscapeJSON(sql) + "\"";
 
@@ -440,6 +482,27 @@ D1QueryResult D1ExecuteQuery(const D1Config &config, const string &sql, const ve
 	return ParseD1Response(response);
 }
 
+D1QueryResult D1ExecuteQuery(const D1Config &config, const string &sql, const vector<string> &params) {
+	// Any statement may write
+	D1WriteScope write(config);
+	return D1PostQuery(config, sql, params);
+}
+
+// D1 reads in flight, across all queries and connections
+static SingleFlight<D1QueryResult> &D1ReadFlights() {
+	// Intentionally leaked: reads may still be running at process exit
+	static auto flights = new SingleFlight<D1QueryResult>();
+	return *flights;
+}
+
+D1QueryResult D1ExecuteRead(const D1Config &config, const string &sql) {
+	// The token is part of the key so a result is never handed to a caller with different credentials; the write
+	// generation keeps reads issued after a write from joining a read sent before it
+	string key = D1DatabaseKey(config) + "\n" + config.api_token + "\n" + to_string(D1WriteGeneration(config)) +
+	             "\n" + sql;
+	return *D1ReadFlights().Do(key, [&config, &sql]() { return D1PostQuery(config, sql, vector<string>()); });
+}
+
 // ========================================
 // D1 BATCH EXECUTION
 // ========================================
@@ -540,6 +603,7 @@ D1BatchResult D1ExecuteBatch(const D1Config &config, const vector<string> &state
 	body += "]";
 
 	// Execute request - batch uses the query endpoint with array body
+	D1WriteScope write(config);
 	string response = HTTPPost(config.GetQueryUrl(), body, config.api_token);
 
 	// Parse batch response
@@ -616,7 +680,7 @@ string D1GetDatabaseIdByName(const D1Config &config, const string &name) {
 vector<D1TableInfo> D1GetTables(const D1Config &config) {
 	vector<D1TableInfo> tables;
 
-	auto result = D1ExecuteQuery(config, "PRAGMA table_list");
+	auto result = D1ExecuteRead(config, "PRAGMA table_list");
 	if (!result.success) {
 		throw IOException("Failed to get table list: " + result.error);
 	}
@@ -669,7 +733,7 @@ vector<D1TableInfo> D1GetTables(const D1Config &config) {
 vector<D1ColumnInfo> D1GetTableColumns(const D1Config &config, const string &table_name) {
 	vector<D1ColumnInfo> columns;
 
-	auto result = D1ExecuteQuery(config, "PRAGMA table_info(" + table_name + ")");
+	auto result = D1ExecuteRead(config, "PRAGMA table_info(" + table_name + ")");
 	if (!result.success) {
 		throw IOException("Failed to get table columns: " + result.error);
 	}
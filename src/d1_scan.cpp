@@ -244,7 +244,7 @@ static void D1ScanFunction(ClientContext &context, TableFunctionInput &data, Dat
 		if (bind_data.limit > 0) {
 			sql += " LIMIT " + std::to_string(bind_data.limit);
 		}
-		bind_data.result = D1ExecuteQuery(bind_data.config, sql);
+		bind_data.result = D1ExecuteRead(bind_data.config, sql);
 		bind_data.executed = true;
 
 		if (!bind_data.result.success) {
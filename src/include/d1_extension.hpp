@@ -141,6 +141,11 @@ struct D1DatabaseInfo {
 // Execute a SQL query against D1 and return the result
 D1QueryResult D1ExecuteQuery(const D1Config &config, const string &sql, const vector<string> &params = {});
 
+// Execute a read-only query against D1. Identical reads running at the same time (same database, credentials and
+// SQL) share one request and its result, unless a statement that may write was sent to the database in between.
+// Never use it for statements that write.
+D1QueryResult D1ExecuteRead(const D1Config &config, const string &sql);
+
 // Execute multiple SQL statements as a batch
 D1BatchResult D1ExecuteBatch(const D1Config &config, const vector<string> &statements);
 
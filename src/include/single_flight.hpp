@@ -0,0 +1,66 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+// ========================================
+// SINGLE FLIGHT
+// ========================================
+
+// Collapses identical concurrent calls: while a call for a key is running, callers with the same key wait for it
+// and share its result (or rethrow its exception) instead of starting their own. Nothing is kept once the call
+// finishes, so this dedups work in flight; it is not a cache.
+// Only use it for idempotent reads, and make the key cover everything the result depends on (including
+// credentials) - callers with equal keys receive the same result.
+template <class T>
+class SingleFlight {
+public:
+	typedef std::shared_ptr<const T> result_t;
+
+	// Run fn for key, or wait for the call already running for key (then joined is set, if given)
+	result_t Do(const string &key, const std::function<T()> &fn, bool *joined = nullptr) {
+		std::shared_future<result_t> result;
+		std::shared_ptr<std::promise<result_t>> promise;
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			auto entry = in_flight.find(key);
+			if (entry != in_flight.end()) {
+				result = entry->second;
+			} else {
+				promise = std::make_shared<std::promise<result_t>>();
+				result = promise->get_future().share();
+				in_flight[key] = result;
+			}
+		}
+		if (joined) {
+			*joined = !promise;
+		}
+		if (!promise) {
+			return result.get();
+		}
+
+		try {
+			promise->set_value(std::make_shared<T>(fn()));
+		} catch (...) {
+			promise->set_exception(std::current_exception());
+		}
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			in_flight.erase(key);
+		}
+		return result.get();
+	}
+
+private:
+	std::mutex lock;
+	std::unordered_map<string, std::shared_future<result_t>> in_flight;
+};
+
+} // namespace duckdb
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace duckdb {
+
+class DBConfig;
+
+// ========================================
+// DISK CACHE
+// ========================================
+
+// Setting names (registered in RegisterWebArchiveCacheSettings)
+static constexpr const char *WEB_ARCHIVE_CACHE_DIR_SETTING = "web_archive_cache_dir";
+static constexpr const char *WEB_ARCHIVE_CACHE_MAX_SIZE_SETTING = "web_archive_cache_max_size";
+static constexpr const char *WEB_ARCHIVE_WAYBACK_CDX_TTL_SETTING = "web_archive_wayback_cdx_ttl";
+static constexpr const char *WEB_ARCHIVE_BODY_CACHE_SIZE_SETTING = "web_archive_body_cache_size";
+
+// Size accounting and LRU order of every entry under one web_archive_cache_dir. All areas of the directory share
+// it, so web_archive_cache_max_size caps the directory as a whole. Entries are addressed by file path.
+class DiskCacheBudget {
+public:
+	explicit DiskCacheBudget(idx_t max_size);
+
+	void SetMaxSize(idx_t max_size);
+	bool Contains(const string &path);
+	// Mark an entry as most recently used, adding or resizing it
+	void Touch(const string &path, idx_t size);
+	// Touch an entry, then pick least recently used entries to remove until the directory fits its cap
+	void Add(const string &path, idx_t size, vector<string> &to_remove);
+
+private:
+	struct Entry {
+		idx_t size;
+		std::list<string>::iterator lru_position;
+	};
+
+	void TouchLocked(const string &path, idx_t size);
+
+	std::mutex lock;
+	idx_t max_size;
+	idx_t total_size;
+	std::list<string> lru; // Most recently used first
+	std::unordered_map<string, Entry> entries;
+};
+
+// Size-capped on-disk cache of opaque byte strings, one file per entry.
+// - Entries are addressed by a string key; the file name is a hash of the key and the key is stored
+//   in the file so hash collisions read as misses
+// - Least recently used entries are removed once web_archive_cache_dir as a whole grows beyond its size cap
+// - Writes go to a temporary file first, so concurrent readers never see partial entries
+// Each cache area (e.g. "content") lives in its own subdirectory of web_archive_cache_dir.
+class DiskCache {
+public:
+	DiskCache(string directory, shared_ptr<DiskCacheBudget> budget);
+
+	// Cache area for the current settings, or nullptr when web_archive_cache_dir is not set or cannot be created
+	static shared_ptr<DiskCache> Get(ClientContext &context, const string &area);
+
+	// Look up an entry; max_age_seconds < 0 accepts entries of any age
+	bool Read(const string &key, string &out, int64_t max_age_seconds = -1);
+	// Store an entry, replacing any previous value for the key
+	void Write(const string &key, const char *data, idx_t size);
+
+private:
+	string EntryPath(const string &file_name) const;
+	static string EntryFileName(const string &key);
+
+	string directory;
+	shared_ptr<DiskCacheBudget> budget; // Shared with the other areas of the cache directory
+	unique_ptr<FileSystem> fs;
+};
+
+// ========================================
+// BODY CACHE
+// ========================================
+
+// In-memory LRU of response bodies addressed by content digest, shared by all queries.
+// Captures with the same CDX digest carry the same body, so a body fetched once serves every other capture of it.
+// Keys name the source as well as the digest (e.g. "wayback:<digest>"). With a DiskCache passed in, bodies are
+// also persisted there and reloaded into memory on a miss. Cached bodies are shared with output vectors and never
+// modified once stored.
+class BodyCache {
+public:
+	explicit BodyCache(idx_t max_size);
+
+	// The body cache with the current size cap, or nullptr when web_archive_body_cache_size is 0
+	static shared_ptr<BodyCache> Get(ClientContext &context);
+
+	// Look up a body in memory, then in disk (if given); nullptr on a miss
+	shared_ptr<string> Read(const string &key, DiskCache *disk = nullptr);
+	// Store a body in memory and in disk (if given). Bodies over a quarter of the cap are only written to disk.
+	void Write(const string &key, shared_ptr<string> body, DiskCache *disk = nullptr);
+
+private:
+	struct Entry {
+		shared_ptr<string> body;
+		std::list<string>::iterator lru_position;
+	};
+
+	// Add or replace an entry and evict down to the cap (lock must be held)
+	void InsertLocked(const string &key, shared_ptr<string> body);
+	// Remove least recently used entries until the cache fits its cap (lock must be held)
+	void EvictLocked();
+
+	std::mutex lock;
+	idx_t max_size;
+	idx_t total_size;
+	std::list<string> lru; // Most recently used first
+	std::unordered_map<string, Entry> entries;
+};
+
+// Seconds a cached Wayback CDX result stays valid (0 disables caching of Wayback CDX results)
+int64_t GetWaybackCDXCacheTTL(ClientContext &context);
+
+// Register web_archive_cache_dir, web_archive_cache_max_size, web_archive_wayback_cdx_ttl and
+// web_archive_body_cache_size
+void RegisterWebArchiveCacheSettings(DBConfig &config);
+
+} // namespace duckdb
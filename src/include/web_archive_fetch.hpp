@@ -0,0 +1,357 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace duckdb {
+
+// ========================================
+// RUNNING TASK COUNT
+// ========================================
+
+// Task copies of one scan that are queued or running but no longer tracked by a future (e.g. the slower copy of a
+// hedged fetch). The scan waits for them before the state they reference goes away.
+class RunningTaskCount {
+public:
+	void Started() {
+		std::lock_guard<std::mutex> guard(lock);
+		count++;
+	}
+	void Finished() {
+		std::lock_guard<std::mutex> guard(lock);
+		if (--count == 0) {
+			all_finished.notify_all();
+		}
+	}
+	void WaitForAll() {
+		std::unique_lock<std::mutex> guard(lock);
+		all_finished.wait(guard, [this]() { return count == 0; });
+	}
+
+private:
+	std::mutex lock;
+	std::condition_variable all_finished;
+	idx_t count = 0;
+};
+
+// ========================================
+// FETCH EXECUTOR
+// ========================================
+
+// Process-wide worker pool for archive fetches (WARC records, archived pages).
+// - Fixed number of worker threads shared by all queries
+// - Per-host concurrency limits so one archive host is never flooded with connections. Each limit adapts to the
+//   responses fed back through RecordResponse (AIMD): it grows by one slot per limit's worth of 2xx responses, up
+//   to twice the starting limit, and halves on 429/503. A Retry-After pauses new work for the host.
+// - Hedged tasks: when a copy is still running after the host's recent p95 latency, a second copy is started and
+//   the first successful result is kept
+// - Bounded queue: Submit blocks while the queue is full (back-pressure on the scan)
+class FetchExecutor {
+public:
+	// Get the shared executor (created on first use)
+	static FetchExecutor &Get();
+
+	// Enqueue a task that talks to the given host
+	void Submit(const string &host, std::function<void()> task);
+
+	// Enqueue a task and return a future for its result
+	template <class T>
+	std::future<T> SubmitTask(const string &host, std::function<T()> fn) {
+		auto task = std::make_shared<std::packaged_task<T()>>(std::move(fn));
+		auto result = task->get_future();
+		Submit(host, [task]() { (*task)(); });
+		return result;
+	}
+
+	// Enqueue a task that may be hedged: fn can run twice and deliver is called exactly once, with the first
+	// result whose `error` member is empty, or with a failed result once no copy is left to succeed. fn is told
+	// whether it runs as the hedge copy, which must not wait on work the first copy may be part of (e.g. a
+	// single-flight download). Copies are counted in running until they finish, which may be after deliver.
+	template <class T>
+	void SubmitHedged(const string &host, std::function<T(bool hedge)> fn, std::function<void(T &)> deliver,
+	                  std::shared_ptr<RunningTaskCount> running) {
+		auto state = std::make_shared<HedgedTask<T>>();
+		state->fn = std::move(fn);
+		state->deliver = std::move(deliver);
+		state->running = std::move(running);
+		state->running->Started();
+		auto host_name = host;
+		Submit(host, [this, host_name, state]() { RunHedgedCopy(host_name, state, false); });
+	}
+
+	// SubmitHedged with the delivered result handed out through a future
+	template <class T>
+	std::future<T> SubmitHedgedTask(const string &host, std::function<T(bool hedge)> fn,
+	                                std::shared_ptr<RunningTaskCount> running) {
+		auto promise = std::make_shared<std::promise<T>>();
+		auto result = promise->get_future();
+		SubmitHedged<T>(
+		    host, std::move(fn), [promise](T &value) { promise->set_value(std::move(value)); }, std::move(running));
+		return result;
+	}
+
+	// Feed the outcome of one HTTP request into the host's concurrency limit (status 0: no response)
+	void RecordResponse(const string &host, long status, int retry_after_seconds, double latency_ms);
+
+	// Milliseconds to wait before retrying a request to host: the backoff with jitter, or until the host's
+	// Retry-After pause is over if that is later
+	int RetryDelayMs(const string &host, int backoff_ms);
+
+	// Number of concurrent fetches a host starts with
+	static idx_t HostConcurrencyLimit(const string &host);
+
+private:
+	typedef std::chrono::steady_clock::time_point time_point_t;
+
+	struct QueuedTask {
+		string host;
+		std::function<void()> task;
+		time_point_t not_before; // Delayed tasks (hedges) are not started before this
+		// Set once the task has nothing left to do; it is then started right away, only to clean up
+		std::shared_ptr<std::atomic<bool>> superseded;
+	};
+
+	// Adaptive limit and recent latencies of one host
+	struct HostState {
+		double limit = 0;   // Current concurrency limit; the integer part is enforced
+		idx_t ceiling = 0;  // Largest limit the host may grow to
+		idx_t active = 0;   // Tasks running against the host
+		idx_t hedges = 0;   // Hedge copies queued or running
+		time_point_t paused_until;   // Retry-After: no new tasks start before this
+		time_point_t last_decrease;  // Last time the limit was cut
+		vector<double> latencies_ms; // Ring buffer of recent successful request latencies
+		idx_t next_latency = 0;
+	};
+
+	// Shared by the copies of a hedged task
+	template <class T>
+	struct HedgedTask {
+		std::function<T(bool hedge)> fn;
+		std::function<void(T &)> deliver;
+		std::shared_ptr<RunningTaskCount> running;
+		std::mutex lock;
+		std::shared_ptr<std::atomic<bool>> delivered = std::make_shared<std::atomic<bool>>(false);
+		idx_t copies_left = 1; // Copies queued or running
+	};
+
+	FetchExecutor(idx_t worker_count, idx_t queue_capacity);
+
+	void WorkerLoop();
+	// Pop the oldest task whose host has capacity and is not paused (lock must be held). When nothing can run,
+	// wake_at is lowered to the earliest time a delayed task or paused host becomes runnable.
+	bool TryPopRunnable(QueuedTask &out, time_point_t &wake_at);
+	// State of a host, created with its starting limit (lock must be held)
+	HostState &GetHostState(const string &host);
+	// Reserve a hedge for a task that just started against host; false when the host has too few latency samples,
+	// was throttled recently or already has its share of hedges
+	bool TryReserveHedge(const string &host, double &delay_ms);
+	void ReleaseHedge(const string &host);
+	// Queue a hedge copy ahead of ordinary tasks, runnable after delay_ms; never blocks on queue capacity
+	void SubmitDelayed(const string &host, double delay_ms, std::function<void()> task,
+	                   std::shared_ptr<std::atomic<bool>> superseded);
+
+	template <class T>
+	void RunHedgedCopy(const string &host, std::shared_ptr<HedgedTask<T>> state, bool is_hedge) {
+		bool skip;
+		{
+			std::lock_guard<std::mutex> guard(state->lock);
+			skip = state->delivered->load();
+			if (skip) {
+				state->copies_left--;
+			}
+		}
+		if (!skip) {
+			double delay_ms;
+			bool hedged = !is_hedge && TryReserveHedge(host, delay_ms);
+			if (hedged) {
+				{
+					std::lock_guard<std::mutex> guard(state->lock);
+					state->copies_left++;
+				}
+				state->running->Started();
+				SubmitDelayed(
+				    host, delay_ms, [this, host, state]() { RunHedgedCopy(host, state, true); }, state->delivered);
+			}
+			T result;
+			try {
+				result = state->fn(is_hedge);
+			} catch (std::exception &ex) {
+				result.error = ex.what();
+			} catch (...) {
+				result.error = "Unknown error in fetch task";
+			}
+			bool deliver;
+			{
+				std::lock_guard<std::mutex> guard(state->lock);
+				state->copies_left--;
+				deliver = !state->delivered->load() && (result.error.empty() || state->copies_left == 0);
+				if (deliver) {
+					state->delivered->store(true);
+				}
+			}
+			if (deliver) {
+				try {
+					state->deliver(result);
+				} catch (...) {
+					// deliver reports failures through its own results; the copy must still be counted as finished
+				}
+				if (hedged) {
+					// Let the queued hedge copy finish now instead of at its start time
+					work_available.notify_all();
+				}
+			}
+		}
+		if (is_hedge) {
+			ReleaseHedge(host);
+		}
+		state->running->Finished();
+	}
+
+	std::mutex lock;
+	std::condition_variable work_available;
+	std::condition_variable space_available;
+	std::deque<QueuedTask> queue;
+	std::unordered_map<string, HostState> hosts;
+	idx_t queue_capacity;
+};
+
+// ========================================
+// FETCH PIPELINE
+// ========================================
+
+// Keeps up to `depth` record fetches in flight ahead of the scan threads.
+// Fetches are submitted in record order, a window at a time, so the submit function can
+// plan them together (e.g. coalesce neighbouring ranges). Each record's future is taken exactly once.
+template <class T>
+class FetchPipeline {
+public:
+	// Submit fetches for records [begin, end) and append one future per record (in record order) to out
+	typedef std::function<void(idx_t begin, idx_t end, vector<std::future<T>> &out)> submit_function_t;
+
+	FetchPipeline()
+	    : total(0), depth(1), next_submit(0), cancelled(std::make_shared<std::atomic<bool>>(false)),
+	      running(std::make_shared<RunningTaskCount>()) {
+	}
+	~FetchPipeline() {
+		Cancel();
+	}
+
+	void Initialize(idx_t total_p, idx_t depth_p, submit_function_t submit_p) {
+		std::lock_guard<std::mutex> guard(lock);
+		total = total_p;
+		depth = depth_p == 0 ? 1 : depth_p;
+		submit = std::move(submit_p);
+	}
+
+	// Records were appended: fetches may now run up to the new total
+	void Extend(idx_t total_p) {
+		std::lock_guard<std::mutex> guard(lock);
+		total = total_p;
+	}
+
+	// Flag checked by queued fetches before they start; set once the scan is torn down
+	std::shared_ptr<std::atomic<bool>> CancellationFlag() const {
+		return cancelled;
+	}
+
+	// Hedged fetch copies still running for this pipeline; Cancel waits for them
+	std::shared_ptr<RunningTaskCount> RunningTasks() const {
+		return running;
+	}
+
+	// Take the fetch of a record, submitting it and up to `depth` records beyond it.
+	// The window is refilled once less than half of it is left, so submissions come in batches.
+	std::future<T> Take(idx_t index) {
+		std::lock_guard<std::mutex> guard(lock);
+		idx_t submit_end = index + 1 + depth < total ? index + 1 + depth : total;
+		if (next_submit <= index || next_submit - index - 1 < depth / 2) {
+			if (next_submit < submit_end) {
+				vector<std::future<T>> submitted;
+				submit(next_submit, submit_end, submitted);
+				if (submitted.size() != submit_end - next_submit) {
+					throw InternalException("Fetch pipeline submitted %llu fetches for %llu records",
+					                        (unsigned long long)submitted.size(),
+					                        (unsigned long long)(submit_end - next_submit));
+				}
+				for (auto &future : submitted) {
+					in_flight[next_submit++] = std::move(future);
+				}
+			}
+		}
+		auto entry = in_flight.find(index);
+		if (entry == in_flight.end()) {
+			throw InternalException("Fetch for record %llu was already taken", (unsigned long long)index);
+		}
+		auto result = std::move(entry->second);
+		in_flight.erase(entry);
+		return result;
+	}
+
+	// Drop queued fetches and wait for the running ones (they reference query state)
+	void Cancel() {
+		cancelled->store(true);
+		std::lock_guard<std::mutex> guard(lock);
+		for (auto &entry : in_flight) {
+			if (entry.second.valid()) {
+				entry.second.wait();
+			}
+		}
+		in_flight.clear();
+		running->WaitForAll();
+	}
+
+private:
+	std::mutex lock;
+	idx_t total;
+	idx_t depth;
+	idx_t next_submit;
+	submit_function_t submit;
+	std::unordered_map<idx_t, std::future<T>> in_flight; // Submitted but not yet taken by a scan thread
+	std::shared_ptr<std::atomic<bool>> cancelled;
+	std::shared_ptr<RunningTaskCount> running;
+};
+
+// Fetches taken by one scan thread, in record order
+template <class T>
+struct PendingFetches {
+	std::deque<std::future<T>> futures;
+	std::shared_ptr<std::atomic<bool>> cancelled;
+
+	~PendingFetches() {
+		if (futures.empty()) {
+			return;
+		}
+		// The scan stopped mid-range (e.g. LIMIT satisfied upstream): drop queued fetches, wait for running ones
+		if (cancelled) {
+			cancelled->store(true);
+		}
+		for (auto &future : futures) {
+			if (future.valid()) {
+				future.wait();
+			}
+		}
+	}
+
+	// Wait for the next fetch, then take every consecutive fetch that has already completed (up to max_count)
+	void TakeReady(vector<T> &out, idx_t max_count) {
+		while (!futures.empty() && out.size() < max_count) {
+			if (!out.empty() && futures.front().wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				break;
+			}
+			out.push_back(futures.front().get());
+			futures.pop_front();
+		}
+	}
+};
+
+} // namespace duckdb
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "duckdb.hpp"
+
+#include <functional>
+
+namespace duckdb {
+
+// ========================================
+// RANGE HTTP CLIENT
+// ========================================
+
+// Result of a single ranged GET
+struct RangeResponse {
+	long status = 0;              // HTTP status code (0 when the request never got a response)
+	idx_t bytes_read = 0;         // Bytes written into the caller's buffer
+	int retry_after = -1;         // Retry-After header in seconds (-1 when absent)
+	bool transport_error = false; // Connection/timeout failure (no usable HTTP status)
+	double latency_ms = 0;        // Time the request took, including connection setup
+	string error;                 // Empty on success
+
+	// Worth retrying: connection/timeout failures, throttling and server-side errors
+	bool Retryable() const {
+		return transport_error || status == 429 || status >= 500;
+	}
+};
+
+// Minimal libcurl client for byte-range reads and whole-body GETs against archive hosts.
+// - One client per thread (see ThreadLocal), so keep-alive connections are reused across fetches
+// - GetRange sends exactly one "Range: bytes=offset-(offset+length-1)" GET per call and writes the body straight
+//   into a caller-provided buffer; no per-request handle or file setup
+// - Reports the HTTP status and Retry-After, so callers can tell throttling from other failures
+// - Never touches DuckDB configuration
+class RangeHttpClient {
+public:
+	RangeHttpClient();
+	~RangeHttpClient();
+
+	// Client owned by the calling thread (created on first use)
+	static RangeHttpClient &ThreadLocal();
+
+	// Read bytes [offset, offset + length) of url into buffer, which must hold at least length bytes
+	RangeResponse GetRange(const string &url, idx_t offset, idx_t length, char *buffer, int timeout_seconds);
+	// Read the whole body of url into body (cleared first); any 2xx status is a success
+	RangeResponse Get(const string &url, string &body, int timeout_seconds);
+	// Hand the body of url to on_data as it arrives; only 2xx bodies are passed on. on_data returning false ends
+	// the transfer early, which still counts as a success.
+	RangeResponse Stream(const string &url, const std::function<bool(const char *data, idx_t size)> &on_data,
+	                     int timeout_seconds);
+
+private:
+	void *handle; // CURL easy handle, kept alive between calls for connection reuse
+};
+
+} // namespace duckdb
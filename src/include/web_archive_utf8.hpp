@@ -0,0 +1,158 @@
+#pragma once
+
+// UTF-8 validation used by SanitizeUTF8 and the string writers. Kept free of DuckDB headers so
+// benchmark/sanitize_utf8.cpp can build it on its own.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WEB_ARCHIVE_UTF8_SSE2 1
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define WEB_ARCHIVE_UTF8_AVX2 1
+#endif
+
+namespace duckdb {
+
+// ========================================
+// UTF-8 VALIDATION
+// ========================================
+
+// Length of the well-formed UTF-8 sequence starting at data[0] (RFC 3629: no overlong forms, surrogates or code
+// points above U+10FFFF), or 0 when the bytes there are not one. data[0] must not be ASCII.
+inline size_t UTF8SequenceLength(const unsigned char *data, size_t remaining) {
+	auto c = data[0];
+	size_t len;
+	unsigned char min_second = 0x80, max_second = 0xBF;
+	if (c >= 0xC2 && c <= 0xDF) {
+		len = 2;
+	} else if (c >= 0xE0 && c <= 0xEF) {
+		len = 3;
+		if (c == 0xE0) {
+			min_second = 0xA0; // overlong
+		} else if (c == 0xED) {
+			max_second = 0x9F; // surrogates
+		}
+	} else if (c >= 0xF0 && c <= 0xF4) {
+		len = 4;
+		if (c == 0xF0) {
+			min_second = 0x90; // overlong
+		} else if (c == 0xF4) {
+			max_second = 0x8F; // above U+10FFFF
+		}
+	} else {
+		return 0;
+	}
+	if (remaining < len || data[1] < min_second || data[1] > max_second) {
+		return 0;
+	}
+	for (size_t i = 2; i < len; i++) {
+		if ((data[i] & 0xC0) != 0x80) {
+			return 0;
+		}
+	}
+	return len;
+}
+
+// Index of the lowest set bit of a non-zero movemask
+inline size_t LowestSetBit(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return static_cast<size_t>(__builtin_ctz(mask));
+#endif
+}
+
+// Offset of the first non-ASCII byte at or after pos, or length. Scans a block of bytes per step.
+inline size_t SkipASCII(const char *data, size_t length, size_t pos) {
+#if WEB_ARCHIVE_UTF8_AVX2
+	for (; pos + 32 <= length; pos += 32) {
+		auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+		auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+		if (mask != 0) {
+			return pos + LowestSetBit(mask);
+		}
+	}
+#endif
+#if WEB_ARCHIVE_UTF8_SSE2
+	for (; pos + 16 <= length; pos += 16) {
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(block));
+		if (mask != 0) {
+			return pos + LowestSetBit(mask);
+		}
+	}
+#endif
+	// Eight bytes at a time where no vector unit is available, and for the tail
+	for (; pos + 8 <= length; pos += 8) {
+		uint64_t word;
+		memcpy(&word, data + pos, sizeof(word));
+		if (word & 0x8080808080808080ULL) {
+			break;
+		}
+	}
+	while (pos < length && static_cast<unsigned char>(data[pos]) < 0x80) {
+		pos++;
+	}
+	return pos;
+}
+
+// Byte-at-a-time reference validator, kept for the benchmark and as the definition IsValidUTF8 must match
+inline bool IsValidUTF8Scalar(const char *data, size_t length) {
+	auto bytes = reinterpret_cast<const unsigned char *>(data);
+	for (size_t i = 0; i < length;) {
+		if (bytes[i] < 0x80) {
+			i++;
+			continue;
+		}
+		auto len = UTF8SequenceLength(bytes + i, length - i);
+		if (len == 0) {
+			return false;
+		}
+		i += len;
+	}
+	return true;
+}
+
+// ASCII bytes in a row after which IsValidUTF8 goes back to block scanning
+static constexpr size_t UTF8_ASCII_RUN_FOR_BLOCK_SCAN = 16;
+
+// True when [data, data + length) is well-formed UTF-8. ASCII runs, by far the common case for URLs, digests and
+// header values, are skipped a vector at a time; text with multi-byte sequences is decoded byte by byte until it
+// turns back into a long enough ASCII run.
+inline bool IsValidUTF8(const char *data, size_t length) {
+	auto bytes = reinterpret_cast<const unsigned char *>(data);
+	size_t pos = 0;
+	while (true) {
+		pos = SkipASCII(data, length, pos);
+		if (pos == length) {
+			return true;
+		}
+		size_t ascii_run = 0;
+		while (pos < length && ascii_run < UTF8_ASCII_RUN_FOR_BLOCK_SCAN) {
+			if (bytes[pos] < 0x80) {
+				pos++;
+				ascii_run++;
+				continue;
+			}
+			auto len = UTF8SequenceLength(bytes + pos, length - pos);
+			if (len == 0) {
+				return false;
+			}
+			pos += len;
+			ascii_run = 0;
+		}
+	}
+}
+
+} // namespace duckdb
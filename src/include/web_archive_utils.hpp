@@ -10,10 +10,15 @@
 #include "duckdb/common/types/time.hpp"
 
 #include <zlib.h>
+#include <algorithm>
 #include <vector>
 #include <sstream>
+#include <atomic>
 #include <chrono>
+#include <cstring>
+#include <functional>
 #include <future>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -40,7 +45,8 @@ string LikeToRegex(const string &like_pattern);
 // E.g., "2024-06-01 00:00:00" -> "20240601" (not "20240601000000")
 string ToCdxTimestamp(const string &ts_str);
 
-// Helper to sanitize strings for DuckDB (remove invalid UTF-8 sequences)
+// Helper to sanitize strings for DuckDB: bytes that do not start a well-formed UTF-8 sequence become '?'.
+// Valid input (the common case) is returned as is after a vectorized check.
 string SanitizeUTF8(const string &str);
 
 // Safe wrapper for creating DuckDB string Values
@@ -55,6 +61,9 @@ string ConvertSQLWildcardsToCDX(const string &pattern);
 // Parse CDX timestamp format (YYYYMMDDHHmmss) to DuckDB timestamp
 timestamp_t ParseCDXTimestamp(const string &cdx_timestamp);
 
+// Extract the host part of an http(s) URL (e.g., "data.commoncrawl.org")
+string GetUrlHost(const string &url);
+
 // ========================================
 // GZIP DECOMPRESSION
 // ========================================
@@ -62,30 +71,89 @@ timestamp_t ParseCDXTimestamp(const string &cdx_timestamp);
 // Helper function to decompress gzip data using zlib
 string DecompressGzip(const char *compressed_data, size_t compressed_size);
 
+// How far DecompressGzipPrefix got
+enum class GzipPrefixResult : uint8_t {
+	COMPLETE,       // The whole stream was inflated
+	STOPPED,        // The stop condition was met before the end of the stream
+	INPUT_EXHAUSTED // The input ended mid-stream (e.g. only a prefix of the record was fetched)
+};
+
+// Inflate a gzip stream only as far as needed: stop() is checked on the output after every inflated chunk.
+// Errors are reported like DecompressGzip, as an "[Error: ...]" string in out.
+GzipPrefixResult DecompressGzipPrefix(const char *compressed_data, size_t compressed_size,
+                                      const std::function<bool(const string &out)> &stop, string &out);
+
 // ========================================
 // HTTP/WARC PARSING
 // ========================================
 
-// Structure to hold parsed WARC response
+// A byte range inside an inflated WARC record (WARCResponse::data)
+struct WARCSpan {
+	idx_t offset = 0;
+	idx_t length = 0;
+};
+
+// One header line of a WARC or HTTP header block
+struct WARCHeaderSpan {
+	WARCSpan name;
+	WARCSpan value;
+};
+
+// Parsed WARC response record. The parser only records where each part sits in the inflated record;
+// nothing is copied until the scan writes the fields the query reads into its output vectors.
 struct WARCResponse {
-	string warc_version;                        // e.g., "1.0" from "WARC/1.0"
-	unordered_map<string, string> warc_headers; // WARC header fields as map
-	string http_version;                        // e.g., "1.1" from "HTTP/1.1"
-	int http_status_code;                       // e.g., 200 from "HTTP/1.1 200"
-	unordered_map<string, string> http_headers; // HTTP header fields as map
-	string body;                                // HTTP response body
-	string error;                               // Error message if fetch failed (empty on success)
+	shared_ptr<string> data;             // Inflated record; output vectors may keep it alive to reference the body
+	WARCSpan warc_version;               // e.g., "1.0" from "WARC/1.0"
+	vector<WARCHeaderSpan> warc_headers; // WARC header fields in record order
+	WARCSpan http_version;               // e.g., "1.1" from "HTTP/1.1"
+	int http_status_code;                // e.g., 200 from "HTTP/1.1 200"
+	vector<WARCHeaderSpan> http_headers; // HTTP header fields in record order (duplicates kept)
+	WARCSpan body;                       // HTTP response body
+	bool body_truncated;                 // Body was cut short by a byte cap (see DecodeWARCRecord)
+	string error;                        // Error message if fetch failed (empty on success)
+
+	WARCResponse() : data(make_shared_ptr<string>()), http_status_code(0), body_truncated(false) {
+	}
 
-	WARCResponse() : http_status_code(0) {
+	const char *Ptr(const WARCSpan &span) const {
+		return data->data() + span.offset;
 	}
 };
 
-// Helper function to parse headers into a map
-// Handles multi-value headers by concatenating with ", "
-unordered_map<string, string> ParseHeaders(const string &header_text);
+// Record the name/value spans of the "Name: value" lines in data[begin, end)
+void ParseHeaderSpans(const string &data, idx_t begin, idx_t end, vector<WARCHeaderSpan> &headers);
 
-// Helper function to parse WARC format and extract structured WARC/HTTP headers and body
-WARCResponse ParseWARCResponse(const string &warc_data);
+// Parse the inflated record in response.data in place: locate the WARC headers, the HTTP status line and
+// headers, and the body (header lines the query does not read can be skipped)
+void ParseWARCResponse(WARCResponse &response, bool parse_warc_headers = true, bool parse_http_headers = true);
+
+// Offset of the HTTP body in a (possibly partial) WARC record: just past the blank lines ending the WARC and
+// the HTTP headers. Returns string::npos while the headers are still incomplete.
+idx_t FindWARCPayloadStart(const string &warc_data);
+
+// ========================================
+// STRUCT PROJECTION
+// ========================================
+
+// Fields of a STRUCT column that the query reads: all of them, unless DuckDB pushed a struct field
+// projection (e.g. only response.body) into the scan
+vector<bool> ProjectedStructFields(const ColumnIndex &column, idx_t field_count);
+
+// Write one row of a MAP(VARCHAR, VARCHAR) vector from header spans of a record.
+// Repeated header names become one entry with their values joined by ", ".
+void WriteHeaderMap(Vector &map_vector, idx_t row, const WARCResponse &response,
+                    const vector<WARCHeaderSpan> &headers);
+
+// Add bytes to a VARCHAR vector with a single copy, repairing invalid UTF-8 only when present
+string_t AddSanitizedString(Vector &vector, const char *data, idx_t length);
+string_t AddSanitizedString(Vector &vector, const string &str);
+
+// Reference bytes of a shared buffer from a BLOB/VARCHAR vector without copying them
+// (the vector keeps the buffer alive)
+string_t AddSharedBlob(Vector &vector, const shared_ptr<string> &buffer, const char *data, idx_t length);
+
+// Set one row of a STRUCT child that the query does not read to NULL
+void SetUnusedStructField(Vector &child, idx_t row);
 
 // ========================================
 // CDX RECORD TYPES
@@ -105,6 +173,19 @@ struct CDXRecord {
 
 	CDXRecord() : offset(0), length(0), status_code(0) {
 	}
+
+	// Reset for parsing the next line, keeping the string buffers
+	void Clear() {
+		url.clear();
+		filename.clear();
+		offset = 0;
+		length = 0;
+		timestamp.clear();
+		mime_type.clear();
+		digest.clear();
+		status_code = 0;
+		crawl_id.clear();
+	}
 };
 
 // Structure to hold Internet Archive CDX record data
@@ -119,8 +200,378 @@ struct ArchiveOrgRecord {
 
 	ArchiveOrgRecord() : status_code(0), length(0) {
 	}
+
+	// Reset for parsing the next line, keeping the string buffers
+	void Clear() {
+		urlkey.clear();
+		timestamp.clear();
+		original.clear();
+		mime_type.clear();
+		status_code = 0;
+		digest.clear();
+		length = 0;
+	}
+};
+
+// ========================================
+// COLUMNAR RECORD BATCHES
+// ========================================
+
+// The values of one string column stored back to back in a single buffer: a column costs two allocations no
+// matter how many rows it holds
+struct CDXStringColumn {
+	string bytes;       // All values, concatenated
+	vector<idx_t> ends; // End offset of each row's value in bytes
+
+	idx_t Size() const {
+		return ends.size();
+	}
+	const char *Data(idx_t row) const {
+		return bytes.data() + Start(row);
+	}
+	idx_t Length(idx_t row) const {
+		return ends[row] - Start(row);
+	}
+	string Get(idx_t row) const {
+		return string(Data(row), Length(row));
+	}
+	void Append(const char *data, idx_t length) {
+		bytes.append(data, length);
+		ends.push_back(bytes.size());
+	}
+	void Append(const string &value) {
+		Append(value.data(), value.size());
+	}
+	// Append rows [begin, begin + count) of another column
+	void AppendRows(const CDXStringColumn &other, idx_t begin, idx_t count);
+
+private:
+	idx_t Start(idx_t row) const {
+		return row == 0 ? 0 : ends[row - 1];
+	}
+};
+
+// Common Crawl index results stored column by column, with timestamps parsed once on the way in.
+// All rows of a batch come from one crawl.
+struct CDXRecordBatch {
+	string crawl_id;
+	string index_url; // Index query that produced the batch (debug cdx_url column); not cached
+	CDXStringColumn url;
+	CDXStringColumn filename;
+	CDXStringColumn mime_type;
+	CDXStringColumn digest;
+	vector<timestamp_t> timestamp;
+	vector<int32_t> status_code;
+	vector<int64_t> offset;
+	vector<int64_t> length;
+
+	idx_t Size() const {
+		return url.Size();
+	}
+	// Add a parsed record (its crawl_id is the batch's)
+	void Append(const CDXRecord &record);
+	void Append(const CDXRecord &record, timestamp_t record_timestamp);
+	// Append rows [begin, begin + count) of another batch of the same crawl
+	void AppendRows(const CDXRecordBatch &other, idx_t begin, idx_t count);
+};
+
+// All results of one scan, moved in a batch at a time (one per crawl for common_crawl_index, one per group of
+// looked-up URLs for wayback_machine) and addressed by a scan-wide row number.
+// Scan threads may read earlier batches while a new one is added, provided Reserve was called with the number of
+// batches up front: slots then never move, and a batch only becomes visible once it is complete.
+template <class BATCH>
+class RecordBatchSet {
+public:
+	void Reserve(idx_t max_batches) {
+		batches.resize(max_batches);
+		batch_starts.resize(max_batches);
+	}
+	// Add a batch (one writer at a time)
+	void Add(BATCH batch) {
+		if (batch.Size() == 0) {
+			return;
+		}
+		auto index = batch_count.load();
+		auto start = total_rows.load();
+		if (index == batches.size()) {
+			batches.emplace_back();
+			batch_starts.push_back(0);
+		}
+		batch_starts[index] = start;
+		batches[index] = std::move(batch);
+		auto rows = batches[index].Size();
+		// Publish the batch before its rows, so any row below Size() can be located
+		batch_count.store(index + 1);
+		total_rows.store(start + rows);
+	}
+	idx_t Size() const {
+		return total_rows.load();
+	}
+	// The batch holding a scan-wide row; row is rewritten to the row's index inside that batch
+	const BATCH &Locate(idx_t &row) const {
+		D_ASSERT(row < total_rows.load());
+		auto starts_end = batch_starts.begin() + NumericCast<int64_t>(batch_count.load());
+		auto entry = std::upper_bound(batch_starts.begin(), starts_end, row) - 1;
+		auto batch_idx = NumericCast<idx_t>(entry - batch_starts.begin());
+		row -= *entry;
+		return batches[batch_idx];
+	}
+
+private:
+	vector<BATCH> batches;
+	vector<idx_t> batch_starts; // Scan-wide row number of each batch's first row
+	std::atomic<idx_t> batch_count {0};
+	std::atomic<idx_t> total_rows {0};
+};
+
+typedef RecordBatchSet<CDXRecordBatch> CDXRecordSet;
+
+// Internet Archive CDX results stored column by column
+struct ArchiveOrgRecordBatch {
+	CDXStringColumn urlkey;
+	CDXStringColumn timestamp; // Kept as YYYYMMDDhhmmss: archived page URLs are built from it
+	CDXStringColumn original;
+	CDXStringColumn mime_type;
+	vector<int32_t> status_code;
+	CDXStringColumn digest;
+	vector<int64_t> length;
+	CDXStringColumn input_url; // URL-list scans: the listed URL each row was found for; empty otherwise, not cached
+	CDXStringColumn lookup_error; // urls := scans: why the row's URL could not be looked up ("" for captures)
+
+	idx_t Size() const {
+		return timestamp.Size();
+	}
+	void Append(const ArchiveOrgRecord &record);
+	// Append rows [begin, begin + count) of another batch (with their input_url and lookup_error when it has them)
+	void AppendRows(const ArchiveOrgRecordBatch &other, idx_t begin, idx_t count);
+	// Materialize one row, e.g. for a page fetch task
+	ArchiveOrgRecord Get(idx_t row) const;
+};
+
+typedef RecordBatchSet<ArchiveOrgRecordBatch> ArchiveOrgRecordSet;
+
+// ========================================
+// PARALLEL SCAN
+// ========================================
+
+// Records per range when the scan fetches WARC records / archived pages (keeps fetch work spread over threads)
+static constexpr idx_t RESPONSE_SCAN_RANGE_SIZE = 128;
+
+// Hands out contiguous record ranges [start, end) to scan threads.
+// The range number doubles as batch index so DuckDB restores order only when the plan requires it.
+struct RecordRangeDispenser {
+	std::mutex lock;
+	idx_t total;
+	idx_t range_size;
+	idx_t next_start;
+	idx_t next_index;
+
+	RecordRangeDispenser() : total(0), range_size(STANDARD_VECTOR_SIZE), next_start(0), next_index(0) {
+	}
+
+	void Initialize(idx_t total_p, idx_t range_size_p) {
+		total = total_p;
+		range_size = MaxValue<idx_t>(range_size_p, 1);
+		next_start = 0;
+		next_index = 0;
+	}
+
+	// Number of ranges (used for MaxThreads)
+	idx_t RangeCount() const {
+		return MaxValue<idx_t>((total + range_size - 1) / range_size, 1);
+	}
+
+	// Claim the next range; returns false when all records have been handed out
+	bool Next(idx_t &start, idx_t &end, idx_t &batch_index) {
+		std::lock_guard<std::mutex> guard(lock);
+		if (next_start >= total) {
+			return false;
+		}
+		start = next_start;
+		end = MinValue<idx_t>(next_start + range_size, total);
+		batch_index = next_index++;
+		next_start = end;
+		return true;
+	}
+
+	// Records were appended: hand out ranges up to the new total
+	void Extend(idx_t total_p) {
+		std::lock_guard<std::mutex> guard(lock);
+		total = total_p;
+	}
+};
+
+// ========================================
+// CDX PAGINATION
+// ========================================
+
+// max_results value for "no cap" (max_results := -1): every page of the CDX result is fetched
+static constexpr idx_t CDX_NO_LIMIT = DConstants::INVALID_INDEX;
+// Results up to this many records are fetched with one CDX request; larger ones are paginated
+static constexpr idx_t CDX_SINGLE_REQUEST_MAX = 10000;
+
+// ========================================
+// CDX STREAMING PARSE
+// ========================================
+
+// Splits a CDX response that arrives in chunks into lines (without "\n" or "\r\n") for on_line.
+// Lines are passed straight out of the chunk when they fit in it; on_line returns false to stop early.
+class CDXLineReader {
+public:
+	explicit CDXLineReader(std::function<bool(const char *line, idx_t length)> on_line);
+
+	// Split the next chunk; false once on_line asked to stop
+	bool Feed(const char *data, idx_t size);
+	// Emit the last line if the response did not end with a newline
+	void Finish();
+
+private:
+	bool Emit(const char *line, idx_t length);
+
+	std::function<bool(const char *line, idx_t length)> on_line;
+	string carry; // Start of a line that continues in the next chunk
+	bool stopped;
+};
+
+// Read a CDX file through the DuckDB file system (local paths or httpfs) and hand each line (without its newline)
+// to on_line as soon as it is complete. Lines are passed straight out of the read buffer; on_line returns false to
+// stop reading early. Index API queries go through RangeHttpClient instead.
+void StreamCDXResponse(ClientContext &context, const string &url,
+                       const std::function<bool(const char *line, idx_t length)> &on_line);
+
+// Assign [data, data + length) to out, repairing it like SanitizeUTF8 only when it is not valid UTF-8
+void AssignSanitized(string &out, const char *data, idx_t length);
+
+// Parse a run of ASCII digits; anything else (e.g. "-" for unknown values) parses as 0. Runs over 18 digits
+// saturate at the int64_t maximum.
+int64_t ParseCDXInteger(const char *data, idx_t length);
+
+// Parse one NDJSON CDX line (Common Crawl index format) straight into a record; false for lines without a url
+bool ParseCDXJsonLine(const char *line, idx_t length, const string &index_name, bool need_warc_fields,
+                      CDXRecord &record);
+
+// Single pass over the members of a flat JSON object line, calling
+// on_field(key, key_length, value, value_length) for each one. String values are passed without their
+// quotes and with escapes left as-is; other values (numbers, literals) are passed verbatim.
+template <class FUNC>
+void ScanJSONFields(const char *line, idx_t length, FUNC &&on_field) {
+	idx_t pos = 0;
+	while (pos < length) {
+		// Key
+		auto key_open = static_cast<const char *>(memchr(line + pos, '"', length - pos));
+		if (!key_open) {
+			return;
+		}
+		idx_t key_start = key_open - line + 1;
+		auto key_close = static_cast<const char *>(memchr(line + key_start, '"', length - key_start));
+		if (!key_close) {
+			return;
+		}
+		idx_t key_end = key_close - line;
+		pos = key_end + 1;
+		while (pos < length && (line[pos] == ' ' || line[pos] == ':')) {
+			pos++;
+		}
+		if (pos >= length) {
+			return;
+		}
+
+		// Value
+		idx_t value_start;
+		idx_t value_end;
+		if (line[pos] == '"') {
+			value_start = ++pos;
+			while (pos < length && line[pos] != '"') {
+				pos += line[pos] == '\\' ? 2 : 1;
+			}
+			value_end = MinValue<idx_t>(pos, length);
+			pos++;
+		} else {
+			value_start = pos;
+			while (pos < length && line[pos] != ',' && line[pos] != '}') {
+				pos++;
+			}
+			value_end = pos;
+			while (value_end > value_start && line[value_end - 1] == ' ') {
+				value_end--;
+			}
+		}
+		on_field(line + key_start, key_end - key_start, line + value_start, value_end - value_start);
+		// Skip to the next member
+		while (pos < length && line[pos] != ',') {
+			pos++;
+		}
+		pos++;
+	}
+}
+
+// ========================================
+// ZIPNUM INDEX
+// ========================================
+
+// Default location of a crawl's ZipNum index ({crawl_id} is replaced by the crawl)
+static constexpr const char *ZIPNUM_DEFAULT_INDEX_PATH =
+    "https://data.commoncrawl.org/cc-index/collections/{crawl_id}/indexes";
+
+// Convert a URL (with or without scheme) to its SURT key, e.g. "https://www.Example.com/A" -> "com,example)/a"
+string UrlToSurt(const string &url);
+
+// How index keys are matched against a URL filter
+enum class SurtMatch : uint8_t {
+	EXACT,  // example.com/page        -> key == com,example)/page
+	PREFIX, // example.com/dir/*       -> key starts with com,example)/dir/
+	DOMAIN  // *.example.com           -> key starts with com,example followed by ')' or ','
 };
 
+// Translate a CDX url pattern into a SURT key range; throws for patterns not anchored on a host
+void ParseSurtRange(const string &url_pattern, string &surt_prefix, SurtMatch &match);
+
+// A CDX API filter parameter ([!][=|~]field:value) split into its parts, for backends that evaluate it themselves
+struct CDXFilterSpec {
+	string field;
+	bool negated = false;
+	bool exact = false; // '=' exact match; otherwise regex search
+	string value;
+};
+
+CDXFilterSpec ParseCDXFilter(const string &filter);
+
+// Query one crawl's ZipNum index directly: cluster.idx is loaded once per index path and binary-searched for
+// the SURT range of url_pattern; only the matching gzip blocks of the cdx-*.gz shards are read.
+// CDX filters and the timestamp range are applied locally. out_index_url describes the lookup for debug output.
+CDXRecordBatch QueryZipNumIndex(ClientContext &context, const string &index_path, const string &crawl_id,
+                                const string &url_pattern, const vector<string> &cdx_filters, idx_t max_results,
+                                timestamp_t ts_from, timestamp_t ts_to, string &out_index_url);
+
+// ========================================
+// PARQUET INDEX
+// ========================================
+
+// Default location of the columnar cc-index table (hive-partitioned by crawl= and subset=)
+static constexpr const char *PARQUET_DEFAULT_INDEX_PATH = "s3://commoncrawl/cc-index/table/cc-main/warc";
+
+// Query one crawl of the columnar cc-index through DuckDB's Parquet reader: the URL pattern becomes a url_surtkey
+// range, CDX filters and the timestamp range become column predicates, and only the crawl=/subset=warc partition
+// is scanned. out_index_url holds the generated SQL for debug output.
+CDXRecordBatch QueryParquetIndex(ClientContext &context, const string &index_path, const string &crawl_id,
+                                 const string &url_pattern, const vector<string> &cdx_filters, idx_t max_results,
+                                 timestamp_t ts_from, timestamp_t ts_to, string &out_index_url);
+
+// ========================================
+// CDX RESULT CACHE
+// ========================================
+
+// Cache key of a CDX query: the URL with its query parameters ordered by name
+// (parameters sharing a name keep their relative order, e.g. successive collapse= fields)
+string NormalizeCDXUrl(const string &cdx_url);
+
+// Compact columnar encoding of parsed CDX results for the on-disk CDX cache.
+// Deserialize returns false for data written by an incompatible version.
+string SerializeCDXRecords(const CDXRecordBatch &records);
+bool DeserializeCDXRecords(const string &data, CDXRecordBatch &records);
+string SerializeArchiveOrgRecords(const ArchiveOrgRecordBatch &records);
+bool DeserializeArchiveOrgRecords(const string &data, ArchiveOrgRecordBatch &records);
+
 // ========================================
 // COLLINFO CACHE
 // ========================================
@@ -136,32 +587,22 @@ struct CrawlInfo {
 	}
 };
 
-// Cache for collinfo.json (1 day TTL)
-struct CollInfoCache {
+// Parsed collinfo.json. Snapshots are immutable once published, so readers keep using theirs while a refresh
+// replaces the cached one.
+struct CollInfo {
 	string latest_crawl_id;
-	vector<CrawlInfo> crawl_infos; // Full list of crawl info with dates
-	std::chrono::system_clock::time_point cached_at;
-	bool is_valid;
-
-	CollInfoCache() : is_valid(false) {
-	}
-
-	bool IsExpired() const {
-		if (!is_valid)
-			return true;
-		auto now = std::chrono::system_clock::now();
-		auto age = std::chrono::duration_cast<std::chrono::hours>(now - cached_at).count();
-		return age >= 24; // 1 day = 24 hours
-	}
+	vector<CrawlInfo> crawl_infos; // Sorted by from_ts (oldest first)
+	vector<timestamp_t> max_to_ts; // Running maximum of to_ts over crawl_infos, for binary search on crawl ends
+	std::chrono::system_clock::time_point fetched_at;
 };
 
-extern CollInfoCache g_collinfo_cache;
-
 // Helper function to fetch the latest crawl_id from collinfo.json (with 1-day caching)
 string GetLatestCrawlId(ClientContext &context);
 
-// Helper function to get all crawl infos (with 1-day caching)
-const vector<CrawlInfo> &GetCrawlInfos(ClientContext &context);
+// Current collinfo.json snapshot (with 1-day caching). Concurrent callers share one download; the cached copy is
+// refreshed in the background before it expires and persisted in the "collinfo" cache area when
+// web_archive_cache_dir is set.
+shared_ptr<const CollInfo> GetCollInfo(ClientContext &context);
 
 // Helper function to find crawl_ids that overlap with a given timestamp range
 vector<string> GetCrawlIdsForTimestampRange(ClientContext &context, timestamp_t from_ts, timestamp_t to_ts);
@@ -1,8 +1,14 @@
 #include "web_archive_utils.hpp"
+#include "web_archive_cache.hpp"
+#include "web_archive_fetch.hpp"
+#include "web_archive_http.hpp"
+#include "single_flight.hpp"
 #include <algorithm>
+#include <deque>
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include "duckdb/common/error_data.hpp"
 #include "duckdb/logging/logger.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_comparison_expression.hpp"
@@ -22,6 +28,9 @@
 
 namespace duckdb {
 
+// Host of CDX queries and archived pages; URL lookups and page fetches share its connection cap
+static constexpr const char *WAYBACK_HOST = "web.archive.org";
+
 // ========================================
 // BIND DATA AND STATE
 // ========================================
@@ -40,6 +49,9 @@ struct WaybackMachineBindData : public TableFunctionData {
 	bool fetch_response;
 	bool cdx_url_only; // True if only cdx_url column is selected (skip network request)
 	string url_filter;
+	vector<string> url_list;                                // URLs looked up one by one (urls := or url IN (...))
+	bool has_url_list;                                      // url_list is set, even if empty
+	bool report_lookup_errors;                              // urls := scans: failed lookups become lookup_error rows
 	string match_type;                                      // exact, prefix, host, domain
 	vector<string> cdx_filters;                             // filter=field:regex
 	string from_date;                                       // YYYYMMDDhhmmss
@@ -52,25 +64,100 @@ struct WaybackMachineBindData : public TableFunctionData {
 	idx_t offset;                                           // offset parameter for pagination
 	bool debug;                                             // Show cdx_url column when true
 	int timeout_seconds;                                    // Timeout for fetch operations (default 180)
+	idx_t prefetch;                                         // Page fetches kept in flight ahead of the scan
 	std::chrono::steady_clock::time_point fetch_start_time; // Track fetch start time
 
 	WaybackMachineBindData()
-	    : fetch_response(false), cdx_url_only(false), url_filter("*"), match_type("exact"), max_results(100),
-	      cdx_url(""), fast_latest(false), order_desc(false), offset(0), debug(false), timeout_seconds(180) {
+	    : fetch_response(false), cdx_url_only(false), url_filter("*"), has_url_list(false),
+	      report_lookup_errors(false), match_type("exact"),
+	      max_results(100), cdx_url(""), fast_latest(false), order_desc(false), offset(0), debug(false),
+	      timeout_seconds(180), prefetch(32) {
 	}
 };
 
+// Output columns of wayback_machine, resolved from the projection once per scan
+enum class WaybackColumn : uint8_t {
+	URL,
+	TIMESTAMP,
+	URLKEY,
+	MIMETYPE,
+	STATUSCODE,
+	DIGEST,
+	LENGTH,
+	RESPONSE,
+	YEAR,
+	MONTH,
+	INPUT_URL,
+	LOOKUP_ERROR,
+	CDX_URL,
+	OTHER // e.g. virtual columns; left untouched
+};
+
+static WaybackColumn ResolveWaybackColumn(const WaybackMachineBindData &bind_data, column_t col_id) {
+	if (col_id >= bind_data.column_names.size()) {
+		return WaybackColumn::OTHER;
+	}
+	auto &name = bind_data.column_names[col_id];
+	if (name == "url") {
+		return WaybackColumn::URL;
+	} else if (name == "timestamp") {
+		return WaybackColumn::TIMESTAMP;
+	} else if (name == "urlkey") {
+		return WaybackColumn::URLKEY;
+	} else if (name == "mimetype") {
+		return WaybackColumn::MIMETYPE;
+	} else if (name == "statuscode") {
+		return WaybackColumn::STATUSCODE;
+	} else if (name == "digest") {
+		return WaybackColumn::DIGEST;
+	} else if (name == "length") {
+		return WaybackColumn::LENGTH;
+	} else if (name == "response") {
+		return WaybackColumn::RESPONSE;
+	} else if (name == "year") {
+		return WaybackColumn::YEAR;
+	} else if (name == "month") {
+		return WaybackColumn::MONTH;
+	} else if (name == "input_url") {
+		return WaybackColumn::INPUT_URL;
+	} else if (name == "lookup_error") {
+		return WaybackColumn::LOOKUP_ERROR;
+	} else if (name == "cdx_url") {
+		return WaybackColumn::CDX_URL;
+	}
+	return WaybackColumn::OTHER;
+}
+
+class WaybackURLLookups;
+
 // Structure to hold global state for wayback_machine table function
 struct WaybackMachineGlobalState : public GlobalTableFunctionState {
-	vector<ArchiveOrgRecord> records;
-	idx_t current_position;
+	ArchiveOrgRecordSet records; // CDX results; URL-list scans add a batch per group of looked-up URLs
 	vector<column_t> column_ids;
+	vector<WaybackColumn> columns;         // column_ids resolved to output columns (one per output vector)
+	vector<bool> response_fields;          // response STRUCT fields the query reads (body, error)
+	RecordRangeDispenser ranges;           // Record ranges handed out to scan threads
+	FetchPipeline<FetchResult> fetches;    // Page fetches submitted ahead of the scan threads
+	unique_ptr<WaybackURLLookups> lookups; // URL-list scans: URLs still to be looked up
+	std::mutex lookup_lock;                // Held while a scan thread waits for the next lookups
+	idx_t expected_ranges = 1;             // URL-list scans: ranges expected once all URLs are looked up
 
-	WaybackMachineGlobalState() : current_position(0) {
-	}
+	~WaybackMachineGlobalState() override; // Defined once WaybackURLLookups is complete
 
 	idx_t MaxThreads() const override {
-		return 1; // Single-threaded
+		// One thread per record range; DuckDB caps this at its own thread count
+		return MaxValue<idx_t>(ranges.RangeCount(), expected_ranges);
+	}
+};
+
+// Per-thread scan state for wayback_machine: the record range currently being emitted
+struct WaybackMachineLocalState : public LocalTableFunctionState {
+	idx_t position;
+	idx_t range_end;
+	idx_t batch_index;
+	PendingFetches<FetchResult> fetches; // Page fetches for [position, range_end)
+
+	WaybackMachineLocalState() : position(0), range_end(0), batch_index(0) {
 	}
 };
 
@@ -116,10 +203,10 @@ static string BuildArchiveOrgCDXUrl(const string &url_pattern, const string &mat
 		cdx_url += "&to=" + to_date;
 	}
 
-	// Add limit (negative for fastLatest to get latest results)
+	// Add limit (negative for fastLatest to get latest results; none when every page is wanted)
 	if (fast_latest) {
 		cdx_url += "&fastLatest=true&limit=-" + to_string(max_results);
-	} else {
+	} else if (max_results != CDX_NO_LIMIT) {
 		cdx_url += "&limit=" + to_string(max_results);
 	}
 
@@ -145,15 +232,150 @@ static string BuildArchiveOrgCDXUrl(const string &url_pattern, const string &mat
 // CDX API QUERY
 // ========================================
 
+// CDX fields of the space-delimited output, resolved once per query instead of per value
+enum class ArchiveOrgCDXField : uint8_t { URLKEY, TIMESTAMP, ORIGINAL, MIMETYPE, STATUSCODE, DIGEST, LENGTH };
+
+static vector<ArchiveOrgCDXField> ResolveArchiveOrgCDXFields(const vector<string> &fields_in_order) {
+	static const std::unordered_map<string, ArchiveOrgCDXField> FIELDS = {
+	    {"urlkey", ArchiveOrgCDXField::URLKEY},         {"timestamp", ArchiveOrgCDXField::TIMESTAMP},
+	    {"original", ArchiveOrgCDXField::ORIGINAL},     {"mimetype", ArchiveOrgCDXField::MIMETYPE},
+	    {"statuscode", ArchiveOrgCDXField::STATUSCODE}, {"digest", ArchiveOrgCDXField::DIGEST},
+	    {"length", ArchiveOrgCDXField::LENGTH}};
+	vector<ArchiveOrgCDXField> result;
+	for (auto &field : fields_in_order) {
+		result.push_back(FIELDS.at(field));
+	}
+	return result;
+}
+
+// Parse one space-delimited CDX line straight into a record; false for malformed lines
+static bool ParseArchiveOrgCDXLine(const char *line, idx_t length, const vector<ArchiveOrgCDXField> &fields,
+                                   ArchiveOrgRecord &record) {
+	idx_t pos = 0;
+	for (auto field : fields) {
+		// Split by space (Internet Archive CDX uses space delimiter for CSV)
+		while (pos < length && line[pos] == ' ') {
+			pos++;
+		}
+		if (pos >= length) {
+			return false; // Fewer values than requested fields
+		}
+		idx_t start = pos;
+		while (pos < length && line[pos] != ' ') {
+			pos++;
+		}
+		const char *value = line + start;
+		idx_t value_length = pos - start;
+
+		switch (field) {
+		case ArchiveOrgCDXField::URLKEY:
+			AssignSanitized(record.urlkey, value, value_length);
+			break;
+		case ArchiveOrgCDXField::TIMESTAMP:
+			AssignSanitized(record.timestamp, value, value_length);
+			break;
+		case ArchiveOrgCDXField::ORIGINAL:
+			AssignSanitized(record.original, value, value_length);
+			break;
+		case ArchiveOrgCDXField::MIMETYPE:
+			AssignSanitized(record.mime_type, value, value_length);
+			break;
+		case ArchiveOrgCDXField::STATUSCODE:
+			record.status_code = NumericCast<int32_t>(ParseCDXInteger(value, value_length));
+			break;
+		case ArchiveOrgCDXField::DIGEST:
+			AssignSanitized(record.digest, value, value_length);
+			break;
+		case ArchiveOrgCDXField::LENGTH:
+			record.length = ParseCDXInteger(value, value_length);
+			break;
+		}
+	}
+	return true;
+}
+
+// Budget for one CDX request, including the transfer of the whole response
+static constexpr int CDX_REQUEST_TIMEOUT_SECONDS = 300;
+
+// Stream a CDX query and parse its lines as they arrive (at most max_records in total).
+// With showResumeKey=true the response ends with a blank line followed by the resume key.
+// Like page downloads, every response is reported to the fetch executor, and throttling, server errors and
+// connection failures are retried with its backoff. A retry starts the response over, so the records of a failed
+// attempt are dropped.
+static void StreamArchiveOrgCDXRecords(ClientContext &context, const string &url,
+                                       const vector<ArchiveOrgCDXField> &fields, idx_t max_records,
+                                       ArchiveOrgRecordBatch &records, string &resume_key) {
+	const int max_retries = 5;
+	int retry_delay_ms = 100;
+	auto &client = RangeHttpClient::ThreadLocal();
+	auto &executor = FetchExecutor::Get();
+
+	for (int attempt = 0; attempt < max_retries; attempt++) {
+		if (attempt > 0) {
+			auto delay_ms = executor.RetryDelayMs(WAYBACK_HOST, retry_delay_ms);
+			DUCKDB_LOG_DEBUG(context, "CDX retry %d/%d after %dms for: %s", attempt, max_retries - 1, delay_ms,
+			                 url.c_str());
+			std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+			retry_delay_ms *= 2; // Exponential backoff
+		}
+
+		ArchiveOrgRecordBatch fetched;
+		string fetched_resume_key;
+		bool after_blank_line = false;
+		ArchiveOrgRecord record;
+		CDXLineReader reader([&](const char *line, idx_t length) {
+			if (records.Size() + fetched.Size() >= max_records) {
+				return false;
+			}
+			if (length == 0) {
+				after_blank_line = true;
+				return true;
+			}
+			if (after_blank_line) {
+				fetched_resume_key.assign(line, length);
+				return false;
+			}
+			record.Clear();
+			if (ParseArchiveOrgCDXLine(line, length, fields, record)) {
+				fetched.Append(record); // Malformed lines are skipped
+			}
+			return true;
+		});
+		auto response = client.Stream(
+		    url, [&reader](const char *data, idx_t size) { return reader.Feed(data, size); },
+		    CDX_REQUEST_TIMEOUT_SECONDS);
+		executor.RecordResponse(WAYBACK_HOST, response.status, response.retry_after, response.latency_ms);
+		if (response.error.empty()) {
+			reader.Finish();
+			records.AppendRows(fetched, 0, fetched.Size());
+			resume_key = std::move(fetched_resume_key);
+			return;
+		}
+		if (!response.Retryable()) {
+			throw IOException(response.error);
+		}
+		if (attempt + 1 == max_retries) {
+			throw IOException("Failed after " + to_string(max_retries) + " retries: " + response.error);
+		}
+	}
+}
+
+// Wayback CDX queries in flight, across all queries
+static SingleFlight<ArchiveOrgRecordBatch> &CDXQueryFlights() {
+	// Intentionally leaked, like the fetch executor whose threads use it
+	static auto flights = new SingleFlight<ArchiveOrgRecordBatch>();
+	return *flights;
+}
+
 // Helper function to query Internet Archive CDX API
-static vector<ArchiveOrgRecord> QueryArchiveOrgCDX(ClientContext &context, const string &url_pattern,
-                                                   const string &match_type, const vector<string> &fields_needed,
-                                                   const vector<string> &cdx_filters, const string &from_date,
-                                                   const string &to_date, idx_t max_results,
-                                                   const vector<string> &collapses, bool fast_latest, idx_t offset,
-                                                   string &out_cdx_url) {
+static ArchiveOrgRecordBatch QueryArchiveOrgCDX(ClientContext &context, const string &url_pattern,
+                                                const string &match_type, const vector<string> &fields_needed,
+                                                const vector<string> &cdx_filters, const string &from_date,
+                                                const string &to_date, idx_t max_results,
+                                                const vector<string> &collapses, bool fast_latest, idx_t offset,
+                                                string &out_cdx_url) {
 	DUCKDB_LOG_DEBUG(context, "QueryArchiveOrgCDX started +%.0fms", ElapsedMs());
-	vector<ArchiveOrgRecord> records;
+	ArchiveOrgRecordBatch records;
 
 	// Build the CDX URL
 	string cdx_url = BuildArchiveOrgCDXUrl(url_pattern, match_type, fields_needed, cdx_filters, from_date, to_date,
@@ -176,115 +398,222 @@ static vector<ArchiveOrgRecord> QueryArchiveOrgCDX(ClientContext &context, const
 	// Store the CDX URL for output
 	out_cdx_url = cdx_url;
 
-	try {
-		// Set force_download to skip HEAD request
-		context.db->GetDatabase(context).config.SetOption("force_download", Value(true));
-
-		auto &fs = FileSystem::GetFileSystem(context);
-		auto file_handle = fs.OpenFile(cdx_url, FileFlags::FILE_FLAGS_READ);
+	// New captures keep arriving, so cached Wayback results are only reused within the TTL
+	auto cache_ttl = GetWaybackCDXCacheTTL(context);
+	auto cdx_cache = cache_ttl > 0 ? DiskCache::Get(context, "cdx") : nullptr;
+	auto cache_key = NormalizeCDXUrl(cdx_url);
+	string cached;
+	if (cdx_cache && cdx_cache->Read(cache_key, cached, cache_ttl) && DeserializeArchiveOrgRecords(cached, records)) {
+		DUCKDB_LOG_DEBUG(context, "CDX cache hit: %lu records +%.0fms", (unsigned long)records.Size(), ElapsedMs());
+		return records;
+	}
 
-		// Read the response
-		string response_data;
-		const idx_t buffer_size = 8192;
-		auto buffer = unique_ptr<char[]>(new char[buffer_size]);
+	// Build list of fields we're requesting (in order)
+	vector<string> fields_in_order;
+	for (const auto &f : ordered_fields) {
+		if (needed_set.count(f)) {
+			fields_in_order.push_back(f);
+		}
+	}
+	auto fields = ResolveArchiveOrgCDXFields(fields_in_order);
 
-		while (true) {
-			int64_t bytes_read = file_handle->Read(buffer.get(), buffer_size);
-			if (bytes_read <= 0) {
-				break;
+	auto download = [&]() {
+		ArchiveOrgRecordBatch fetched_records;
+		try {
+			if (fast_latest || max_results <= CDX_SINGLE_REQUEST_MAX) {
+				string resume_key;
+				StreamArchiveOrgCDXRecords(context, cdx_url, fields, max_results, fetched_records, resume_key);
+			} else {
+				// Large results: follow resume keys page by page (each page depends on the previous one's key)
+				string resume_key;
+				idx_t page_count = 0;
+				do {
+					idx_t page_limit = MinValue<idx_t>(max_results - fetched_records.Size(), CDX_SINGLE_REQUEST_MAX);
+					// The resume key already encodes the position, so the user's offset only applies to the first page
+					idx_t page_offset = page_count == 0 ? offset : 0;
+					string page_url =
+					    BuildArchiveOrgCDXUrl(url_pattern, match_type, fields_needed, cdx_filters, from_date, to_date,
+					                          page_limit, collapses, false, page_offset);
+					page_url += "&showResumeKey=true";
+					if (!resume_key.empty()) {
+						page_url += "&resumeKey=" + resume_key;
+					}
+					resume_key.clear();
+					StreamArchiveOrgCDXRecords(context, page_url, fields, max_results, fetched_records, resume_key);
+					page_count++;
+				} while (!resume_key.empty() && fetched_records.Size() < max_results);
+				DUCKDB_LOG_DEBUG(context, "Fetched %lu CDX pages +%.0fms", (unsigned long)page_count, ElapsedMs());
 			}
-			response_data.append(buffer.get(), bytes_read);
-		}
+			DUCKDB_LOG_DEBUG(context, "Parsed CDX response, got %lu records", (unsigned long)fetched_records.Size());
 
-		// Sanitize UTF-8
-		response_data = SanitizeUTF8(response_data);
+		} catch (std::exception &ex) {
+			throw IOException("Error querying Internet Archive CDX API: " + string(ex.what()));
+		}
 
-		// Build list of fields we're requesting (in order)
-		vector<string> fields_in_order;
-		for (const auto &f : ordered_fields) {
-			if (needed_set.count(f)) {
-				fields_in_order.push_back(f);
-			}
+		if (cdx_cache) {
+			auto encoded = SerializeArchiveOrgRecords(fetched_records);
+			cdx_cache->Write(cache_key, encoded.data(), encoded.size());
 		}
+		return fetched_records;
+	};
 
-		// Parse tab-delimited CSV (fields in same order as fl parameter)
-		std::istringstream stream(response_data);
-		string line;
-		int line_count = 0;
+	// The same query running concurrently (e.g. dashboards refreshing in parallel) shares one download
+	bool joined = false;
+	auto fetched = CDXQueryFlights().Do(cache_key, download, &joined);
+	if (joined) {
+		DUCKDB_LOG_DEBUG(context, "Shared an in-flight CDX query: %lu records +%.0fms", (unsigned long)fetched->Size(),
+		                 ElapsedMs());
+	}
+	return *fetched;
+}
 
-		while (std::getline(stream, line)) {
-			if (line.empty()) {
-				continue;
-			}
-			line_count++;
-
-			// Split by space (Internet Archive CDX uses space delimiter for CSV)
-			vector<string> values;
-			std::istringstream line_stream(line);
-			string value;
-			while (line_stream >> value) {
-				values.push_back(value);
-			}
+// ========================================
+// URL LIST LOOKUPS
+// ========================================
+
+// URL lookups kept in flight per connection the executor allows to web.archive.org
+static constexpr idx_t URL_LOOKUPS_PER_CONNECTION = 2;
+
+// CDX query of one listed URL, with the scan's filters
+static string BuildURLLookupCDXUrl(const WaybackMachineBindData &bind_data, const string &url) {
+	return BuildArchiveOrgCDXUrl(url, bind_data.match_type, bind_data.fields_needed, bind_data.cdx_filters,
+	                             bind_data.from_date, bind_data.to_date, bind_data.max_results, bind_data.collapses,
+	                             bind_data.fast_latest, bind_data.offset);
+}
 
-			if (values.size() < fields_in_order.size()) {
-				continue; // Skip malformed lines
+// Looks up the URLs of a URL-list scan (urls := [...] or WHERE url IN (...)) with one CDX query each and hands
+// their records out in list order, so the scan emits the first URLs' captures while later ones are still queried.
+// - Lookups run on the fetch executor, so together with page fetches they stay within web.archive.org's cap
+// - Only a window of lookups is queued ahead of the scan: none are issued once DuckDB stops pulling rows (LIMIT)
+// - Lookups that already completed behind the one waited for are merged into the same batch, so URLs with few
+//   captures do not each become a tiny chunk
+class WaybackURLLookups {
+public:
+	WaybackURLLookups(ClientContext &context, const WaybackMachineBindData &bind_data)
+	    : context(context), bind_data(bind_data), next_url(0), urls_done(0),
+	      window(URL_LOOKUPS_PER_CONNECTION * FetchExecutor::HostConcurrencyLimit(WAYBACK_HOST)),
+	      cancelled(std::make_shared<std::atomic<bool>>(false)) {
+	}
+
+	~WaybackURLLookups() {
+		// Drop queued lookups and wait for the running ones (they reference the query's context)
+		cancelled->store(true);
+		for (auto &lookup : pending) {
+			if (lookup.valid()) {
+				lookup.wait();
 			}
+		}
+	}
 
-			// Parse data row using known field order
-			ArchiveOrgRecord record;
-			for (size_t i = 0; i < fields_in_order.size(); i++) {
-				const string &field = fields_in_order[i];
-				const string &val = values[i];
-
-				if (field == "urlkey") {
-					record.urlkey = val;
-				} else if (field == "timestamp") {
-					record.timestamp = val;
-				} else if (field == "original") {
-					record.original = val;
-				} else if (field == "mimetype") {
-					record.mime_type = val;
-				} else if (field == "statuscode") {
-					record.status_code = val.empty() || val == "-" ? 0 : std::stoi(val);
-				} else if (field == "digest") {
-					record.digest = val;
-				} else if (field == "length") {
-					record.length = val.empty() || val == "-" ? 0 : std::stoll(val);
+	idx_t URLCount() const {
+		return bind_data.url_list.size();
+	}
+
+	// Wait for the next looked-up URL with captures, plus any lookups right behind it that are already done;
+	// false once every URL is looked up
+	bool Next(ArchiveOrgRecordBatch &batch) {
+		StartLookups();
+		while (!pending.empty()) {
+			do {
+				auto records = pending.front().get();
+				pending.pop_front();
+				urls_done++;
+				if (batch.Size() == 0) {
+					batch = std::move(records);
+				} else {
+					batch.AppendRows(records, 0, records.Size());
 				}
+			} while (!pending.empty() && batch.Size() < STANDARD_VECTOR_SIZE &&
+			         pending.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+			StartLookups();
+			DUCKDB_LOG_DEBUG(context, "Looked up %lu of %lu URLs, %lu records in this batch +%.0fms",
+			                 (unsigned long)urls_done, (unsigned long)URLCount(), (unsigned long)batch.Size(),
+			                 ElapsedMs());
+			if (batch.Size() > 0) {
+				return true;
 			}
-			records.push_back(record);
 		}
-		DUCKDB_LOG_DEBUG(context, "Parsed %d CSV lines, got %lu records", line_count, (unsigned long)records.size());
+		return false;
+	}
 
-	} catch (std::exception &ex) {
-		throw IOException("Error querying Internet Archive CDX API: " + string(ex.what()));
+private:
+	void StartLookups() {
+		while (pending.size() < window && next_url < URLCount()) {
+			auto url = bind_data.url_list[next_url++];
+			auto cancelled_flag = cancelled;
+			// pending is waited for on destruction, so lookups never outlive the scheduler
+			pending.push_back(FetchExecutor::Get().SubmitTask<ArchiveOrgRecordBatch>(
+			    WAYBACK_HOST, [this, url, cancelled_flag]() -> ArchiveOrgRecordBatch {
+				    if (cancelled_flag->load()) {
+					    return ArchiveOrgRecordBatch();
+				    }
+				    string cdx_url;
+				    ArchiveOrgRecordBatch records;
+				    try {
+					    records = QueryArchiveOrgCDX(context, url, bind_data.match_type, bind_data.fields_needed,
+					                                 bind_data.cdx_filters, bind_data.from_date, bind_data.to_date,
+					                                 bind_data.max_results, bind_data.collapses,
+					                                 bind_data.fast_latest, bind_data.offset, cdx_url);
+				    } catch (std::exception &ex) {
+					    if (!bind_data.report_lookup_errors) {
+						    throw;
+					    }
+					    // One failed URL must not end a scan over thousands: it is reported in its own row
+					    ErrorData error(ex);
+					    DUCKDB_LOG_DEBUG(context, "Lookup of %s failed: %s", url.c_str(), error.RawMessage().c_str());
+					    ArchiveOrgRecordBatch failed;
+					    failed.Append(ArchiveOrgRecord());
+					    failed.input_url.Append(url);
+					    failed.lookup_error.Append(error.RawMessage());
+					    return failed;
+				    }
+				    for (idx_t row = 0; row < records.Size(); row++) {
+					    records.input_url.Append(url);
+					    if (bind_data.report_lookup_errors) {
+						    records.lookup_error.Append("", 0);
+					    }
+				    }
+				    return records;
+			    }));
+		}
 	}
 
-	return records;
+	ClientContext &context;
+	const WaybackMachineBindData &bind_data;
+	idx_t next_url;  // Next URL to look up
+	idx_t urls_done; // URLs whose lookup was handed out
+	idx_t window;    // Most lookups queued or running at once
+	std::shared_ptr<std::atomic<bool>> cancelled;
+	// Lookups in flight, in list order
+	std::deque<std::future<ArchiveOrgRecordBatch>> pending;
+};
+
+WaybackMachineGlobalState::~WaybackMachineGlobalState() {
 }
 
 // ========================================
 // ARCHIVED PAGE FETCHING
 // ========================================
 
-// Helper function to fetch archived page from Internet Archive with retry and timeout
-static FetchResult FetchArchivedPage(ClientContext &context, const ArchiveOrgRecord &record,
-                                     std::chrono::steady_clock::time_point start_time, int timeout_seconds) {
-	FetchResult result;
-
-	if (record.timestamp.empty() || record.original.empty()) {
-		result.error = "Missing timestamp or URL";
-		return result;
-	}
+// URL of the raw content of a snapshot: the id_ suffix skips the Wayback Machine's UI wrapper
+static string ArchivedPageUrl(const ArchiveOrgRecord &record) {
+	return "https://" + string(WAYBACK_HOST) + "/web/" + record.timestamp + "id_/" + record.original;
+}
 
-	// Construct the download URL with id_ suffix to get raw content
-	string download_url = "https://web.archive.org/web/" + record.timestamp + "id_/" + record.original;
+// Download an archived page from the Wayback Machine with retry and timeout. Every response is reported to the
+// fetch executor, which adapts the host's concurrency to it.
+static FetchResult DownloadArchivedPage(ClientContext &context, const string &download_url,
+                                        std::chrono::steady_clock::time_point start_time, int timeout_seconds) {
+	FetchResult result;
 
-	// Retry with exponential backoff: 100ms, 200ms, 400ms, 800ms, 1600ms
+	// Retry with jittered exponential backoff from 100ms, stretched to the host's Retry-After pause
 	const int max_retries = 5;
 	int retry_delay_ms = 100;
 	string last_error;
 
+	auto &client = RangeHttpClient::ThreadLocal();
+	auto &executor = FetchExecutor::Get();
+
 	for (int attempt = 0; attempt < max_retries; attempt++) {
 		// Check if timeout exceeded
 		auto elapsed =
@@ -295,61 +624,206 @@ static FetchResult FetchArchivedPage(ClientContext &context, const ArchiveOrgRec
 			return result;
 		}
 
-		try {
-			if (attempt > 0) {
-				DUCKDB_LOG_DEBUG(context, "Retry %d/%d after %dms for: %s", attempt, max_retries - 1,
-				                 retry_delay_ms / 2, download_url.c_str());
-				std::this_thread::sleep_for(std::chrono::milliseconds(retry_delay_ms));
-				retry_delay_ms *= 2; // Exponential backoff
-			} else {
-				DUCKDB_LOG_DEBUG(context, "Fetching archived page: %s", download_url.c_str());
-			}
+		if (attempt > 0) {
+			auto delay_ms = executor.RetryDelayMs(WAYBACK_HOST, retry_delay_ms);
+			DUCKDB_LOG_DEBUG(context, "Retry %d/%d after %dms for: %s", attempt, max_retries - 1, delay_ms,
+			                 download_url.c_str());
+			std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+			retry_delay_ms *= 2; // Exponential backoff
+		} else {
+			DUCKDB_LOG_DEBUG(context, "Fetching archived page: %s", download_url.c_str());
+		}
+
+		auto remaining = timeout_seconds - static_cast<int>(elapsed);
+		auto response = client.Get(download_url, result.body, remaining);
+		executor.RecordResponse(WAYBACK_HOST, response.status, response.retry_after, response.latency_ms);
+		if (response.error.empty()) {
+			return result; // Success - error is empty
+		}
+
+		last_error = response.error;
+		// Retry on connection errors, throttling and server-side failures; a Retry-After pauses the whole host
+		if (!response.Retryable()) {
+			result.error = last_error;
+			return result;
+		}
+	}
 
-			// Set force_download to skip HEAD request
-			context.db->GetDatabase(context).config.SetOption("force_download", Value(true));
+	result.error = "Failed after " + to_string(max_retries) + " retries: " + last_error;
+	return result;
+}
 
-			auto &fs = FileSystem::GetFileSystem(context);
-			auto file_handle = fs.OpenFile(download_url, FileFlags::FILE_FLAGS_READ);
+// Archived page downloads in flight, across all queries
+static SingleFlight<FetchResult> &PageFetchFlights() {
+	// Intentionally leaked, like the fetch executor whose threads use it
+	static auto flights = new SingleFlight<FetchResult>();
+	return *flights;
+}
 
-			// Read the response
-			string response_data;
-			const idx_t buffer_size = 8192;
-			auto buffer = unique_ptr<char[]>(new char[buffer_size]);
+// Fetch an archived page. A download of the same snapshot already in flight (from this or another query) is joined
+// instead of downloading it again, unless join_in_flight is false.
+static FetchResult FetchArchivedPage(ClientContext &context, const ArchiveOrgRecord &record, int timeout_seconds,
+                                     bool join_in_flight) {
+	if (record.timestamp.empty() || record.original.empty()) {
+		FetchResult result;
+		result.error = "Missing timestamp or URL";
+		return result;
+	}
+	auto download_url = ArchivedPageUrl(record);
+	// Timeout budget starts when the download actually begins, not when it was queued
+	auto download = [&]() {
+		return DownloadArchivedPage(context, download_url, std::chrono::steady_clock::now(), timeout_seconds);
+	};
+	if (!join_in_flight) {
+		return download();
+	}
+	bool joined = false;
+	auto result = PageFetchFlights().Do(download_url, download, &joined);
+	if (joined) {
+		DUCKDB_LOG_DEBUG(context, "Shared an in-flight download of %s", download_url.c_str());
+	}
+	return *result;
+}
 
-			while (true) {
-				int64_t bytes_read = file_handle->Read(buffer.get(), buffer_size);
-				if (bytes_read <= 0) {
-					break;
-				}
-				response_data.append(buffer.get(), bytes_read);
-			}
+// Cache key of an archived page: the snapshot it was captured in
+static string ArchivedPageCacheKey(const ArchiveOrgRecord &record) {
+	return record.timestamp + " " + record.original;
+}
 
-			result.body = response_data;
-			return result; // Success - error is empty
+// Body cache key of an archived page: its content digest
+static string ArchivedBodyCacheKey(const string &digest) {
+	return "wayback:" + digest;
+}
+
+// Per-scan settings shared by all page fetch tasks
+struct PageFetchOptions {
+	std::shared_ptr<std::atomic<bool>> cancelled; // Set once the scan is torn down
+	std::shared_ptr<RunningTaskCount> running;    // Fetch copies the scan waits for before tearing down
+	int timeout_seconds = 180;
+	shared_ptr<DiskCache> cache;      // Persisted pages without a digest, by snapshot (nullptr when disabled)
+	shared_ptr<BodyCache> bodies;     // Bodies by digest (nullptr when disabled)
+	shared_ptr<DiskCache> body_store; // Persisted bodies by digest (nullptr when the local cache is disabled)
+};
 
-		} catch (Exception &ex) {
-			last_error = ex.what();
-			// Check for retryable HTTP errors (503, 504)
-			string error_str = last_error;
-			bool is_retryable = error_str.find("503") != string::npos || error_str.find("504") != string::npos ||
-			                    error_str.find("Service Unavailable") != string::npos ||
-			                    error_str.find("Gateway Timeout") != string::npos ||
-			                    error_str.find("connection") != string::npos ||
-			                    error_str.find("timeout") != string::npos;
-			if (!is_retryable && attempt == 0) {
-				// Non-retryable error on first attempt, fail immediately
-				result.error = last_error;
-				return result;
+// Look up a page with a digest in the body cache, then on disk; false on a miss
+static bool ReadCachedArchivedBody(const PageFetchOptions &options, const string &digest, string &out) {
+	auto key = ArchivedBodyCacheKey(digest);
+	if (options.bodies) {
+		auto body = options.bodies->Read(key, options.body_store.get());
+		if (!body) {
+			return false;
+		}
+		out = *body;
+		return true;
+	}
+	return options.body_store && options.body_store->Read(key, out);
+}
+
+// Keep a fetched page: by digest when the capture has one, so captures sharing it are stored once, otherwise by
+// snapshot
+static void WriteCachedArchivedPage(const PageFetchOptions &options, const ArchiveOrgRecord &record,
+                                    const string &body) {
+	if (record.digest.empty()) {
+		if (options.cache) {
+			options.cache->Write(ArchivedPageCacheKey(record), body.data(), body.size());
+		}
+		return;
+	}
+	auto key = ArchivedBodyCacheKey(record.digest);
+	if (options.bodies) {
+		options.bodies->Write(key, make_shared_ptr<string>(body), options.body_store.get());
+	} else if (options.body_store) {
+		options.body_store->Write(key, body.data(), body.size());
+	}
+}
+
+// Records of a fetch window waiting on the same page fetch
+typedef vector<std::promise<FetchResult>> PageFetchWaiters;
+
+static void DeliverArchivedPage(PageFetchWaiters &waiters, FetchResult &result) {
+	for (idx_t i = 0; i + 1 < waiters.size(); i++) {
+		waiters[i].set_value(result);
+	}
+	waiters.back().set_value(std::move(result));
+}
+
+// Queue one archived page fetch on the shared executor; skipped if the scan is cancelled before it starts.
+// A fetch slower than the host's recent p95 is hedged with a second copy and the first success is kept.
+static void SubmitArchivedPageFetch(ClientContext &context, const ArchiveOrgRecord &record,
+                                    std::shared_ptr<PageFetchOptions> options,
+                                    std::shared_ptr<PageFetchWaiters> waiters) {
+	FetchExecutor::Get().SubmitHedged<FetchResult>(
+	    WAYBACK_HOST,
+	    [&context, record, options](bool hedge) -> FetchResult {
+		    FetchResult result;
+		    if (options->cancelled->load()) {
+			    result.error = "Fetch cancelled";
+			    return result;
+		    }
+		    // Snapshots never change once captured, so cached pages are served regardless of age. Pages with a
+		    // digest were already looked up by digest before this fetch was queued.
+		    if (record.digest.empty() && options->cache &&
+		        options->cache->Read(ArchivedPageCacheKey(record), result.body)) {
+			    return result;
+		    }
+		    // The hedge copy downloads on its own rather than waiting on the download it is meant to race
+		    result = FetchArchivedPage(context, record, options->timeout_seconds, !hedge);
+		    if (result.error.empty()) {
+			    WriteCachedArchivedPage(*options, record, result.body);
+		    }
+		    return result;
+	    },
+	    [waiters](FetchResult &result) { DeliverArchivedPage(*waiters, result); }, options->running);
+}
+
+// Queue page fetches for records [begin, end); futures are appended to out in record order.
+// Captures with the same digest have the same body: only the first record of each digest in the window is
+// fetched and the others get copies of its result, and digests found in the body cache are not fetched at all.
+static void SubmitArchivedPageFetches(ClientContext &context, const ArchiveOrgRecordSet &records, idx_t begin,
+                                      idx_t end, std::shared_ptr<PageFetchOptions> options,
+                                      vector<std::future<FetchResult>> &out) {
+	vector<std::pair<ArchiveOrgRecord, std::shared_ptr<PageFetchWaiters>>> fetches;
+	std::unordered_map<string, std::shared_ptr<PageFetchWaiters>> by_digest;
+	idx_t shared = 0;
+	for (idx_t i = begin; i < end; i++) {
+		idx_t row = i;
+		auto &batch = records.Locate(row);
+		auto record = batch.Get(row);
+		std::shared_ptr<PageFetchWaiters> waiters;
+		if (!record.digest.empty()) {
+			auto entry = by_digest.find(record.digest);
+			if (entry != by_digest.end()) {
+				waiters = entry->second;
+				shared++;
 			}
-			// Continue to retry on retryable errors
-		} catch (std::exception &ex) {
-			last_error = ex.what();
-			// Continue to retry on connection errors
 		}
+		if (!waiters) {
+			waiters = std::make_shared<PageFetchWaiters>();
+			if (!record.digest.empty()) {
+				by_digest[record.digest] = waiters;
+			}
+			fetches.emplace_back(std::move(record), waiters);
+		}
+		waiters->emplace_back();
+		out.push_back(waiters->back().get_future());
+	}
+	if (shared > 0) {
+		DUCKDB_LOG_DEBUG(context, "%llu of %llu archived pages share a digest with an earlier page",
+		                 (unsigned long long)shared, (unsigned long long)(end - begin));
 	}
 
-	result.error = "Failed after " + to_string(max_retries) + " retries: " + last_error;
-	return result;
+	// Every waiter is registered before any fetch is queued, so deliveries see the complete lists
+	for (auto &fetch : fetches) {
+		auto &record = fetch.first;
+		if (!record.digest.empty()) {
+			FetchResult result;
+			if (ReadCachedArchivedBody(*options, record.digest, result.body)) {
+				DeliverArchivedPage(*fetch.second, result);
+				continue;
+			}
+		}
+		SubmitArchivedPageFetch(context, record, options, fetch.second);
+	}
 }
 
 // ========================================
@@ -370,7 +844,9 @@ static unique_ptr<FunctionData> WaybackMachineBind(ClientContext &context, Table
 			if (kv.second.type().id() != LogicalTypeId::BIGINT) {
 				throw BinderException("wayback_machine max_results parameter must be an integer");
 			}
-			bind_data->max_results = kv.second.GetValue<int64_t>();
+			// Negative max_results lifts the cap: resume keys are followed until the result is exhausted
+			auto max_results = kv.second.GetValue<int64_t>();
+			bind_data->max_results = max_results < 0 ? CDX_NO_LIMIT : NumericCast<idx_t>(max_results);
 			DUCKDB_LOG_DEBUG(context, "CDX API max_results set to: %lu", (unsigned long)bind_data->max_results);
 		} else if (kv.first == "collapse") {
 			if (kv.second.type().id() != LogicalTypeId::VARCHAR) {
@@ -390,6 +866,26 @@ static unique_ptr<FunctionData> WaybackMachineBind(ClientContext &context, Table
 			}
 			bind_data->timeout_seconds = kv.second.GetValue<int64_t>();
 			DUCKDB_LOG_DEBUG(context, "Timeout set to: %d seconds", bind_data->timeout_seconds);
+		} else if (kv.first == "prefetch") {
+			if (kv.second.type().id() != LogicalTypeId::BIGINT || kv.second.GetValue<int64_t>() <= 0) {
+				throw BinderException("wayback_machine prefetch parameter must be a positive integer");
+			}
+			bind_data->prefetch = kv.second.GetValue<int64_t>();
+			DUCKDB_LOG_DEBUG(context, "Prefetch depth set to: %lu", (unsigned long)bind_data->prefetch);
+		} else if (kv.first == "urls") {
+			if (kv.second.IsNull() || kv.second.type().id() != LogicalTypeId::LIST ||
+			    ListType::GetChildType(kv.second.type()).id() != LogicalTypeId::VARCHAR) {
+				throw BinderException("wayback_machine urls parameter must be a list of strings");
+			}
+			// Each distinct URL is looked up once, in list order; NULL and empty entries are skipped
+			std::set<string> seen;
+			for (auto &url : ListValue::GetChildren(kv.second)) {
+				if (!url.IsNull() && !url.ToString().empty() && seen.insert(url.ToString()).second) {
+					bind_data->url_list.push_back(url.ToString());
+				}
+			}
+			bind_data->has_url_list = true;
+			DUCKDB_LOG_DEBUG(context, "URL list with %lu URLs", (unsigned long)bind_data->url_list.size());
 		} else {
 			throw BinderException("Unknown parameter '%s' for wayback_machine", kv.first.c_str());
 		}
@@ -439,6 +935,16 @@ static unique_ptr<FunctionData> WaybackMachineBind(ClientContext &context, Table
 	names.push_back("month");
 	return_types.push_back(LogicalType::INTEGER);
 
+	// Add input_url column only for urls := lookups (the listed URL each capture was found for), and lookup_error
+	// for URLs whose CDX query failed: such a URL gets one row with only input_url and lookup_error set
+	if (bind_data->has_url_list) {
+		names.push_back("input_url");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.push_back("lookup_error");
+		return_types.push_back(LogicalType::VARCHAR);
+		bind_data->report_lookup_errors = true;
+	}
+
 	// Add cdx_url column only when debug := true
 	if (bind_data->debug) {
 		names.push_back("cdx_url");
@@ -459,8 +965,8 @@ static unique_ptr<GlobalTableFunctionState> WaybackMachineInitGlobal(ClientConte
 	DUCKDB_LOG_DEBUG(context, "WaybackMachineInitGlobal called +%.0fms", ElapsedMs());
 	auto &bind_data = const_cast<WaybackMachineBindData &>(input.bind_data->Cast<WaybackMachineBindData>());
 
-	// Validate URL filter - don't allow queries without a specific URL
-	if (bind_data.url_filter == "*" || bind_data.url_filter.empty()) {
+	// Validate URL filter - don't allow queries without a specific URL (or URL list)
+	if (!bind_data.has_url_list && (bind_data.url_filter == "*" || bind_data.url_filter.empty())) {
 		throw InvalidInputException("wayback_machine() requires a URL filter. Use WHERE url = 'example.com', WHERE url "
 		                            "LIKE 'example.com/%', or WHERE url LIKE '%.example.com' for subdomains");
 	}
@@ -469,6 +975,16 @@ static unique_ptr<GlobalTableFunctionState> WaybackMachineInitGlobal(ClientConte
 
 	// Store projected columns
 	state->column_ids = input.column_ids;
+	for (auto &col_id : input.column_ids) {
+		state->columns.push_back(ResolveWaybackColumn(bind_data, col_id));
+	}
+	state->response_fields = vector<bool>(2, true);
+	for (auto &column : input.column_indexes) {
+		auto col_id = column.GetPrimaryIndex();
+		if (col_id < bind_data.column_names.size() && bind_data.column_names[col_id] == "response") {
+			state->response_fields = ProjectedStructFields(column, 2);
+		}
+	}
 
 	// Rebuild fields_needed based on projection pushdown
 	// Map column names to CDX API field names
@@ -495,14 +1011,19 @@ static unique_ptr<GlobalTableFunctionState> WaybackMachineInitGlobal(ClientConte
 			} else if (col_name == "response") {
 				bind_data.fetch_response = true;
 				DUCKDB_LOG_DEBUG(context, "Will fetch response bodies");
+				// Pages with the same digest are fetched once
+				if (std::find(bind_data.fields_needed.begin(), bind_data.fields_needed.end(), "digest") ==
+				    bind_data.fields_needed.end()) {
+					bind_data.fields_needed.push_back("digest");
+				}
 			} else if (col_name == "year" || col_name == "month") {
 				// year and month need timestamp field
 				if (std::find(bind_data.fields_needed.begin(), bind_data.fields_needed.end(), "timestamp") ==
 				    bind_data.fields_needed.end()) {
 					bind_data.fields_needed.push_back("timestamp");
 				}
-			} else if (col_name == "cdx_url") {
-				// cdx_url doesn't need any CDX fields
+			} else if (col_name == "cdx_url" || col_name == "input_url" || col_name == "lookup_error") {
+				// cdx_url, input_url and lookup_error don't need any CDX fields
 			}
 		}
 	}
@@ -552,144 +1073,336 @@ static unique_ptr<GlobalTableFunctionState> WaybackMachineInitGlobal(ClientConte
 		                          bind_data.collapses, bind_data.fast_latest, bind_data.offset);
 		DUCKDB_LOG_DEBUG(context, "CDX URL +%.0fms: %s", ElapsedMs(), bind_data.cdx_url.c_str());
 
-		// Create a single dummy record so we return one row with the cdx_url
+		// Create a single dummy record so we return one row with the cdx_url (one per URL for URL lists)
 		ArchiveOrgRecord dummy;
 		dummy.timestamp = "202501010000"; // Dummy timestamp for year/month extraction
-		state->records.push_back(dummy);
+		ArchiveOrgRecordBatch dummies;
+		if (bind_data.has_url_list) {
+			for (auto &url : bind_data.url_list) {
+				dummies.Append(dummy);
+				dummies.input_url.Append(url);
+			}
+		} else {
+			dummies.Append(dummy);
+		}
+		state->records.Add(std::move(dummies));
+	} else if (bind_data.has_url_list) {
+		// URL list: the scan reads each URL's captures as its lookup completes
+		state->lookups = make_uniq<WaybackURLLookups>(context, bind_data);
+		state->records.Reserve(state->lookups->URLCount());
+		idx_t expected_rows = bind_data.max_results == CDX_NO_LIMIT
+		                          ? CDX_NO_LIMIT
+		                          : bind_data.max_results * state->lookups->URLCount();
+		idx_t range_size = bind_data.fetch_response ? RESPONSE_SCAN_RANGE_SIZE : STANDARD_VECTOR_SIZE;
+		state->expected_ranges =
+		    expected_rows == CDX_NO_LIMIT ? DConstants::INVALID_INDEX : (expected_rows + range_size - 1) / range_size;
+		DUCKDB_LOG_DEBUG(context, "Looking up %lu URLs +%.0fms", (unsigned long)state->lookups->URLCount(),
+		                 ElapsedMs());
 	} else {
 		// Query Internet Archive CDX API
-		state->records =
-		    QueryArchiveOrgCDX(context, bind_data.url_filter, bind_data.match_type, bind_data.fields_needed,
-		                       bind_data.cdx_filters, bind_data.from_date, bind_data.to_date, bind_data.max_results,
-		                       bind_data.collapses, bind_data.fast_latest, bind_data.offset, bind_data.cdx_url);
+		state->records.Add(QueryArchiveOrgCDX(context, bind_data.url_filter, bind_data.match_type,
+		                                      bind_data.fields_needed, bind_data.cdx_filters, bind_data.from_date,
+		                                      bind_data.to_date, bind_data.max_results, bind_data.collapses,
+		                                      bind_data.fast_latest, bind_data.offset, bind_data.cdx_url));
+		DUCKDB_LOG_DEBUG(context, "QueryArchiveOrgCDX returned %lu records +%.0fms",
+		                 (unsigned long)state->records.Size(), ElapsedMs());
 	}
 
-	DUCKDB_LOG_DEBUG(context, "QueryArchiveOrgCDX returned %lu records +%.0fms", (unsigned long)state->records.size(),
-	                 ElapsedMs());
+	// Response scans use small ranges so page fetches spread over threads
+	state->ranges.Initialize(state->records.Size(),
+	                         bind_data.fetch_response ? RESPONSE_SCAN_RANGE_SIZE : STANDARD_VECTOR_SIZE);
+
+	// Page fetches run ahead of the scan threads, at most `prefetch` records beyond the furthest one claimed
+	if (bind_data.fetch_response) {
+		auto records = &state->records;
+		auto options = std::make_shared<PageFetchOptions>();
+		options->cancelled = state->fetches.CancellationFlag();
+		options->running = state->fetches.RunningTasks();
+		options->timeout_seconds = bind_data.timeout_seconds;
+		options->cache = DiskCache::Get(context, "content");
+		options->bodies = BodyCache::Get(context);
+		options->body_store = DiskCache::Get(context, "bodies");
+		state->fetches.Initialize(state->records.Size(), bind_data.prefetch,
+		                          [&context, records, options](idx_t begin, idx_t end,
+		                                                       vector<std::future<FetchResult>> &out) {
+			                          SubmitArchivedPageFetches(context, *records, begin, end, options, out);
+		                          });
+	}
 
 	return std::move(state);
 }
 
-// Scan function for wayback_machine table function
-static void WaybackMachineScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
-	auto &bind_data = data.bind_data->Cast<WaybackMachineBindData>();
-	auto &gstate = data.global_state->Cast<WaybackMachineGlobalState>();
+// Init local state function for wayback_machine
+static unique_ptr<LocalTableFunctionState> WaybackMachineInitLocal(ExecutionContext &context,
+                                                                   TableFunctionInitInput &input,
+                                                                   GlobalTableFunctionState *global_state) {
+	return make_uniq<WaybackMachineLocalState>();
+}
 
-	// Pre-fetch responses in parallel for this chunk if needed
-	std::vector<FetchResult> response_results;
-	idx_t chunk_size = std::min<idx_t>(STANDARD_VECTOR_SIZE, gstate.records.size() - gstate.current_position);
+// ========================================
+// COLUMN WRITERS
+// ========================================
 
-	if (bind_data.fetch_response && chunk_size > 0) {
-		DUCKDB_LOG_DEBUG(context, "Pre-fetching %lu archived pages in parallel", (unsigned long)chunk_size);
-		std::vector<std::future<FetchResult>> response_futures;
-		response_futures.reserve(chunk_size);
+// Each projected column is filled for the whole chunk in one loop (column-major), dispatched once per chunk
+
+template <class T>
+static void WriteFixedColumn(Vector &vector, const duckdb::vector<T> &column, idx_t begin, idx_t count) {
+	memcpy(FlatVector::GetData<T>(vector), column.data() + begin, count * sizeof(T));
+}
+
+static void WriteStringColumn(Vector &vector, const CDXStringColumn &column, idx_t begin, idx_t count) {
+	auto data = FlatVector::GetData<string_t>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		data[row] = AddSanitizedString(vector, column.Data(begin + row), column.Length(begin + row));
+	}
+}
 
-		// Record start time for timeout tracking
-		auto fetch_start = std::chrono::steady_clock::now();
-		int timeout = bind_data.timeout_seconds;
+static void WriteTimestampColumn(Vector &vector, const CDXStringColumn &column, idx_t begin, idx_t count) {
+	auto data = FlatVector::GetData<timestamp_t>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		data[row] = ParseCDXTimestamp(column.Get(begin + row));
+	}
+}
 
-		// Launch parallel fetches
-		for (idx_t i = 0; i < chunk_size; i++) {
-			auto &record = gstate.records[gstate.current_position + i];
-			response_futures.push_back(std::async(std::launch::async, [&context, record, fetch_start, timeout]() {
-				return FetchArchivedPage(context, record, fetch_start, timeout);
-			}));
+// year/month from the YYYYMMDDhhmmss timestamp; NULL when those digits are missing
+template <idx_t START, idx_t LENGTH>
+static void WriteTimestampPartColumn(Vector &vector, const CDXStringColumn &column, idx_t begin, idx_t count) {
+	auto data = FlatVector::GetData<int32_t>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		auto timestamp = column.Data(begin + row);
+		bool valid = column.Length(begin + row) >= START + LENGTH;
+		int32_t value = 0;
+		for (idx_t i = START; valid && i < START + LENGTH; i++) {
+			valid = timestamp[i] >= '0' && timestamp[i] <= '9';
+			value = value * 10 + (timestamp[i] - '0');
+		}
+		if (valid) {
+			data[row] = value;
+		} else {
+			FlatVector::SetNull(vector, row, true);
 		}
+	}
+}
 
-		// Collect results
-		response_results.reserve(chunk_size);
-		for (auto &future : response_futures) {
-			response_results.push_back(future.get());
+// Response STRUCT with body and error fields; fields the query does not read stay NULL
+static void WriteResponseColumn(Vector &struct_vector, const vector<FetchResult> &results,
+                                const vector<bool> &used_fields, idx_t count) {
+	auto &struct_children = StructVector::GetEntries(struct_vector);
+	// Child 0: body (BLOB), only copied when the query reads it
+	auto &body_vector = *struct_children[0];
+	auto body_data = FlatVector::GetData<string_t>(body_vector);
+	for (idx_t row = 0; row < count; row++) {
+		if (used_fields[0]) {
+			body_data[row] = StringVector::AddStringOrBlob(body_vector, results[row].body);
+		} else {
+			SetUnusedStructField(body_vector, row);
 		}
-		DUCKDB_LOG_DEBUG(context, "All %lu archived pages fetched", (unsigned long)chunk_size);
 	}
+	// Child 1: error (VARCHAR), NULL on success
+	auto &error_vector = *struct_children[1];
+	auto error_data = FlatVector::GetData<string_t>(error_vector);
+	for (idx_t row = 0; row < count; row++) {
+		if (results[row].error.empty() || !used_fields[1]) {
+			FlatVector::SetNull(error_vector, row, true);
+		} else {
+			error_data[row] = StringVector::AddString(error_vector, results[row].error);
+		}
+	}
+}
 
-	idx_t output_offset = 0;
-	while (gstate.current_position < gstate.records.size() && output_offset < STANDARD_VECTOR_SIZE) {
-		auto &record = gstate.records[gstate.current_position];
+static void WriteConstantStringColumn(Vector &vector, const string &value, idx_t count) {
+	auto data = FlatVector::GetData<string_t>(vector);
+	if (count > 0) {
+		data[0] = StringVector::AddString(vector, value);
+	}
+	for (idx_t row = 1; row < count; row++) {
+		data[row] = data[0];
+	}
+}
 
-		// Process each projected column
-		for (idx_t proj_idx = 0; proj_idx < gstate.column_ids.size(); proj_idx++) {
-			auto col_id = gstate.column_ids[proj_idx];
-			string col_name = bind_data.column_names[col_id];
+// URL-list scans: the CDX query each row's URL was looked up with
+static void WriteURLLookupCDXUrlColumn(Vector &vector, const WaybackMachineBindData &bind_data,
+                                       const CDXStringColumn &input_url, idx_t begin, idx_t count) {
+	auto data = FlatVector::GetData<string_t>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		data[row] = StringVector::AddString(vector, BuildURLLookupCDXUrl(bind_data, input_url.Get(begin + row)));
+	}
+}
 
-			try {
-				if (col_name == "url") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] =
-					    StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.original));
-				} else if (col_name == "timestamp") {
-					auto data_ptr = FlatVector::GetData<timestamp_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = ParseCDXTimestamp(record.timestamp);
-				} else if (col_name == "urlkey") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] =
-					    StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.urlkey));
-				} else if (col_name == "mimetype") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] =
-					    StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.mime_type));
-				} else if (col_name == "statuscode") {
-					auto data_ptr = FlatVector::GetData<int32_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = record.status_code;
-				} else if (col_name == "digest") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] =
-					    StringVector::AddString(output.data[proj_idx], SanitizeUTF8(record.digest));
-				} else if (col_name == "length") {
-					auto data_ptr = FlatVector::GetData<int64_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = record.length;
-				} else if (col_name == "response") {
-					if (bind_data.fetch_response && !response_results.empty()) {
-						FetchResult &result = response_results[output_offset];
-						// Response STRUCT with body and error fields
-						auto &struct_vector = output.data[proj_idx];
-						auto &struct_children = StructVector::GetEntries(struct_vector);
-						// Child 0: body (BLOB)
-						auto &body_vector = struct_children[0];
-						auto body_data = FlatVector::GetData<string_t>(*body_vector);
-						body_data[output_offset] = StringVector::AddStringOrBlob(*body_vector, result.body);
-						// Child 1: error (VARCHAR)
-						auto &error_vector = struct_children[1];
-						auto error_data = FlatVector::GetData<string_t>(*error_vector);
-						if (result.error.empty()) {
-							FlatVector::SetNull(*error_vector, output_offset, true);
-						} else {
-							error_data[output_offset] = StringVector::AddString(*error_vector, result.error);
-						}
-					} else {
-						FlatVector::SetNull(output.data[proj_idx], output_offset, true);
-					}
-				} else if (col_name == "year") {
-					// Extract year from timestamp (format: YYYYMMDDhhmmss)
-					auto data_ptr = FlatVector::GetData<int32_t>(output.data[proj_idx]);
-					if (record.timestamp.length() >= 4) {
-						data_ptr[output_offset] = std::stoi(record.timestamp.substr(0, 4));
-					} else {
-						FlatVector::SetNull(output.data[proj_idx], output_offset, true);
-					}
-				} else if (col_name == "month") {
-					// Extract month from timestamp (format: YYYYMMDDhhmmss)
-					auto data_ptr = FlatVector::GetData<int32_t>(output.data[proj_idx]);
-					if (record.timestamp.length() >= 6) {
-						data_ptr[output_offset] = std::stoi(record.timestamp.substr(4, 2));
-					} else {
-						FlatVector::SetNull(output.data[proj_idx], output_offset, true);
+// URL-list scans: why a listed URL's lookup failed, NULL for its captures
+static void WriteLookupErrorColumn(Vector &vector, const CDXStringColumn &lookup_error, idx_t begin, idx_t count) {
+	auto data = FlatVector::GetData<string_t>(vector);
+	for (idx_t row = 0; row < count; row++) {
+		if (begin + row >= lookup_error.Size() || lookup_error.Length(begin + row) == 0) {
+			FlatVector::SetNull(vector, row, true);
+		} else {
+			data[row] = StringVector::AddString(vector, lookup_error.Get(begin + row));
+		}
+	}
+}
+
+// The row of a failed lookup has no capture: everything but input_url, lookup_error and cdx_url is NULL
+static void SetFailedLookupRowsNull(const WaybackMachineGlobalState &gstate, const ArchiveOrgRecordBatch &records,
+                                    idx_t begin, idx_t count, DataChunk &output) {
+	if (records.lookup_error.Size() == 0) {
+		return;
+	}
+	for (idx_t row = 0; row < count; row++) {
+		if (records.lookup_error.Length(begin + row) == 0) {
+			continue;
+		}
+		for (idx_t proj_idx = 0; proj_idx < gstate.columns.size(); proj_idx++) {
+			auto column = gstate.columns[proj_idx];
+			if (column != WaybackColumn::INPUT_URL && column != WaybackColumn::LOOKUP_ERROR &&
+			    column != WaybackColumn::CDX_URL && column != WaybackColumn::OTHER) {
+				FlatVector::SetNull(output.data[proj_idx], row, true);
+			}
+		}
+	}
+}
+
+// Emit up to one chunk of rows from the thread's current record range
+static idx_t WaybackMachineScanRange(ClientContext &context, const WaybackMachineBindData &bind_data,
+                                     WaybackMachineGlobalState &gstate, WaybackMachineLocalState &lstate,
+                                     DataChunk &output) {
+	vector<FetchResult> response_results;
+	idx_t chunk_size = std::min<idx_t>(STANDARD_VECTOR_SIZE, lstate.range_end - lstate.position);
+	// A range may span batches; each chunk stays within one
+	idx_t begin = lstate.position;
+	auto &records = gstate.records.Locate(begin);
+	chunk_size = MinValue<idx_t>(chunk_size, records.Size() - begin);
+
+	if (bind_data.fetch_response && chunk_size > 0) {
+		// Emit rows as soon as their pages arrive: wait for the next record only, then take
+		// every following record whose fetch already completed (no barrier on the whole chunk)
+		lstate.fetches.TakeReady(response_results, chunk_size);
+		chunk_size = response_results.size();
+		DUCKDB_LOG_DEBUG(context, "%lu archived pages ready", (unsigned long)chunk_size);
+	}
+
+	for (idx_t proj_idx = 0; proj_idx < gstate.columns.size(); proj_idx++) {
+		auto &column_vector = output.data[proj_idx];
+		try {
+			switch (gstate.columns[proj_idx]) {
+			case WaybackColumn::URL:
+				WriteStringColumn(column_vector, records.original, begin, chunk_size);
+				break;
+			case WaybackColumn::TIMESTAMP:
+				WriteTimestampColumn(column_vector, records.timestamp, begin, chunk_size);
+				break;
+			case WaybackColumn::URLKEY:
+				WriteStringColumn(column_vector, records.urlkey, begin, chunk_size);
+				break;
+			case WaybackColumn::MIMETYPE:
+				WriteStringColumn(column_vector, records.mime_type, begin, chunk_size);
+				break;
+			case WaybackColumn::STATUSCODE:
+				WriteFixedColumn(column_vector, records.status_code, begin, chunk_size);
+				break;
+			case WaybackColumn::DIGEST:
+				WriteStringColumn(column_vector, records.digest, begin, chunk_size);
+				break;
+			case WaybackColumn::LENGTH:
+				WriteFixedColumn(column_vector, records.length, begin, chunk_size);
+				break;
+			case WaybackColumn::RESPONSE:
+				if (bind_data.fetch_response && !response_results.empty()) {
+					WriteResponseColumn(column_vector, response_results, gstate.response_fields, chunk_size);
+				} else {
+					for (idx_t row = 0; row < chunk_size; row++) {
+						FlatVector::SetNull(column_vector, row, true);
 					}
-				} else if (col_name == "cdx_url") {
-					auto data_ptr = FlatVector::GetData<string_t>(output.data[proj_idx]);
-					data_ptr[output_offset] = StringVector::AddString(output.data[proj_idx], bind_data.cdx_url);
 				}
-			} catch (const std::exception &ex) {
-				DUCKDB_LOG_ERROR(context, "Failed to process column %s: %s", col_name.c_str(), ex.what());
+				break;
+			case WaybackColumn::YEAR:
+				WriteTimestampPartColumn<0, 4>(column_vector, records.timestamp, begin, chunk_size);
+				break;
+			case WaybackColumn::MONTH:
+				WriteTimestampPartColumn<4, 2>(column_vector, records.timestamp, begin, chunk_size);
+				break;
+			case WaybackColumn::INPUT_URL:
+				WriteStringColumn(column_vector, records.input_url, begin, chunk_size);
+				break;
+			case WaybackColumn::LOOKUP_ERROR:
+				WriteLookupErrorColumn(column_vector, records.lookup_error, begin, chunk_size);
+				break;
+			case WaybackColumn::CDX_URL:
+				if (bind_data.has_url_list) {
+					WriteURLLookupCDXUrlColumn(column_vector, bind_data, records.input_url, begin, chunk_size);
+				} else {
+					WriteConstantStringColumn(column_vector, bind_data.cdx_url, chunk_size);
+				}
+				break;
+			case WaybackColumn::OTHER:
+				break;
 			}
+		} catch (const std::exception &ex) {
+			DUCKDB_LOG_ERROR(context, "Failed to process column %s: %s",
+			                 bind_data.column_names[gstate.column_ids[proj_idx]].c_str(), ex.what());
 		}
+	}
+	SetFailedLookupRowsNull(gstate, records, begin, chunk_size, output);
+	lstate.position += chunk_size;
 
-		output_offset++;
-		gstate.current_position++;
+	return chunk_size;
+}
+
+// Append the next looked-up URLs' records once all ranges so far are claimed; false when there are no more.
+// seen_rows is the record count the caller saw before it failed to claim a range.
+static bool LoadNextLookups(WaybackMachineGlobalState &gstate, idx_t seen_rows) {
+	if (!gstate.lookups) {
+		return false;
+	}
+	std::lock_guard<std::mutex> guard(gstate.lookup_lock);
+	if (gstate.records.Size() != seen_rows) {
+		// Another thread appended lookups meanwhile
+		return true;
+	}
+	ArchiveOrgRecordBatch batch;
+	if (!gstate.lookups->Next(batch)) {
+		return false;
+	}
+	gstate.records.Add(std::move(batch));
+	gstate.ranges.Extend(gstate.records.Size());
+	gstate.fetches.Extend(gstate.records.Size());
+	return true;
+}
+
+// Scan function for wayback_machine table function
+static void WaybackMachineScan(ClientContext &context, TableFunctionInput &data, DataChunk &output) {
+	auto &bind_data = data.bind_data->Cast<WaybackMachineBindData>();
+	auto &gstate = data.global_state->Cast<WaybackMachineGlobalState>();
+	auto &lstate = data.local_state->Cast<WaybackMachineLocalState>();
+
+	// Claim the next record range once the current one is exhausted
+	while (lstate.position >= lstate.range_end) {
+		auto seen_rows = gstate.records.Size();
+		if (!gstate.ranges.Next(lstate.position, lstate.range_end, lstate.batch_index)) {
+			if (LoadNextLookups(gstate, seen_rows)) {
+				continue;
+			}
+			output.SetCardinality(0);
+			return;
+		}
+		if (bind_data.fetch_response) {
+			// Taking the range's fetches also tops up the prefetch window beyond it
+			lstate.fetches.cancelled = gstate.fetches.CancellationFlag();
+			for (idx_t i = lstate.position; i < lstate.range_end; i++) {
+				lstate.fetches.futures.push_back(gstate.fetches.Take(i));
+			}
+		}
 	}
+	output.SetCardinality(WaybackMachineScanRange(context, bind_data, gstate, lstate, output));
+}
 
-	output.SetCardinality(output_offset);
+// Report the record range being emitted as batch index (lets DuckDB preserve insertion order across threads)
+static OperatorPartitionData WaybackMachineGetPartitionData(ClientContext &context,
+                                                            TableFunctionGetPartitionInput &input) {
+	if (input.partition_info.RequiresPartitionColumns()) {
+		throw InternalException("wayback_machine does not support partition columns");
+	}
+	auto &lstate = input.local_state->Cast<WaybackMachineLocalState>();
+	return OperatorPartitionData(lstate.batch_index);
 }
 
 // ========================================
@@ -802,6 +1515,36 @@ static bool TryHandleInExpression(ClientContext &context, WaybackMachineBindData
 	return true;
 }
 
+// Helper to handle url IN ('a.com', 'b.com', ...): the URLs are looked up one by one, like urls := [...].
+// Only when no other url filter or URL list was pushed down (those stay DuckDB filters on the result)
+static bool TryHandleUrlInExpression(ClientContext &context, WaybackMachineBindData &bind_data,
+                                     BoundOperatorExpression &op) {
+	if (bind_data.has_url_list || bind_data.url_filter != "*") {
+		return false;
+	}
+	vector<string> urls;
+	std::set<string> seen;
+	for (idx_t j = 1; j < op.children.size(); j++) {
+		if (op.children[j]->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			return false;
+		}
+		auto &const_expr = op.children[j]->Cast<BoundConstantExpression>();
+		if (const_expr.value.type().id() != LogicalTypeId::VARCHAR) {
+			return false;
+		}
+		// NULL never matches; an empty URL is not a lookup
+		if (!const_expr.value.IsNull() && !const_expr.value.ToString().empty() &&
+		    seen.insert(const_expr.value.ToString()).second) {
+			urls.push_back(const_expr.value.ToString());
+		}
+	}
+	bind_data.url_list = std::move(urls);
+	bind_data.has_url_list = true;
+	DUCKDB_LOG_DEBUG(context, "url IN -> %lu URL lookups +%.0fms", (unsigned long)bind_data.url_list.size(),
+	                 ElapsedMs());
+	return true;
+}
+
 // Filter pushdown for wayback_machine
 static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
                                                 vector<unique_ptr<Expression>> &filters) {
@@ -832,7 +1575,8 @@ static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalG
 				auto &col_ref = func.children[0]->Cast<BoundColumnRefExpression>();
 				auto &constant = func.children[1]->Cast<BoundConstantExpression>();
 
-				if (col_ref.GetName() == "url" && constant.value.type().id() == LogicalTypeId::VARCHAR) {
+				if (col_ref.GetName() == "url" && !bind_data.has_url_list &&
+				    constant.value.type().id() == LogicalTypeId::VARCHAR) {
 					bind_data.url_filter = constant.value.ToString();
 					// Replace SQL % wildcards with CDX API * wildcards
 					for (size_t pos = 0; pos < bind_data.url_filter.size(); ++pos) {
@@ -903,7 +1647,8 @@ static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalG
 
 				// Handle suffix(url, '.domain.com') -> url=*.domain.com
 				// CDX server auto-detects matchType from wildcard pattern, no need to specify
-				if (col_name == "url" && constant.value.type().id() == LogicalTypeId::VARCHAR) {
+				if (col_name == "url" && !bind_data.has_url_list &&
+				    constant.value.type().id() == LogicalTypeId::VARCHAR) {
 					string suffix_val = constant.value.ToString();
 					// For URL suffix like '.example.com', use wildcard prefix
 					bind_data.url_filter = "*" + suffix_val;
@@ -932,7 +1677,8 @@ static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalG
 				string col_name = col_ref.GetName();
 
 				// Handle prefix(url, 'pattern') -> url=pattern* (special case)
-				if (col_name == "url" && constant.value.type().id() == LogicalTypeId::VARCHAR) {
+				if (col_name == "url" && !bind_data.has_url_list &&
+				    constant.value.type().id() == LogicalTypeId::VARCHAR) {
 					bind_data.url_filter = constant.value.ToString() + "*";
 					DUCKDB_LOG_DEBUG(context, "URL prefix: %s +%.0fms", bind_data.url_filter.c_str(), ElapsedMs());
 					filters_to_remove.push_back(i);
@@ -1157,7 +1903,8 @@ static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalG
 			}
 		}
 
-		// Handle IN expressions: statuscode IN (200, 301, 302) or mimetype IN ('text/html', 'text/plain')
+		// Handle IN expressions: statuscode IN (200, 301, 302) or mimetype IN ('text/html', 'text/plain'),
+		// url IN ('a.com', 'b.com') becomes a URL list
 		// DuckDB converts IN to COMPARE_IN operator expression
 		if (filter->GetExpressionClass() == ExpressionClass::BOUND_OPERATOR &&
 		    filter->type == ExpressionType::COMPARE_IN) {
@@ -1168,6 +1915,11 @@ static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalG
 				auto &col_ref = op.children[0]->Cast<BoundColumnRefExpression>();
 				string col_name = col_ref.GetName();
 
+				if (col_name == "url" && TryHandleUrlInExpression(context, bind_data, op)) {
+					filters_to_remove.push_back(i);
+					continue;
+				}
+
 				// statuscode is integer, mimetype is string
 				bool is_integer = (col_name == "statuscode");
 				if (TryHandleInExpression(context, bind_data, op, col_name, is_integer)) {
@@ -1214,8 +1966,8 @@ static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalG
 		auto &constant = comparison.right->Cast<BoundConstantExpression>();
 		string column_name = col_ref.GetName();
 
-		// Handle URL filtering via equality/LIKE
-		if (column_name == "url" && constant.value.type().id() == LogicalTypeId::VARCHAR) {
+		// Handle URL filtering via equality/LIKE (URL-list scans leave url filters to DuckDB)
+		if (column_name == "url" && !bind_data.has_url_list && constant.value.type().id() == LogicalTypeId::VARCHAR) {
 			if (filter->type == ExpressionType::COMPARE_EQUAL) {
 				bind_data.url_filter = constant.value.ToString();
 				bind_data.match_type = "exact";
@@ -1320,6 +2072,13 @@ static void WaybackMachinePushdownComplexFilter(ClientContext &context, LogicalG
 // Cardinality function for wayback_machine
 static unique_ptr<NodeStatistics> WaybackMachineCardinality(ClientContext &context, const FunctionData *bind_data_p) {
 	auto &bind_data = bind_data_p->Cast<WaybackMachineBindData>();
+	if (bind_data.max_results == CDX_NO_LIMIT) {
+		return make_uniq<NodeStatistics>();
+	}
+	if (bind_data.has_url_list) {
+		// Up to max_results per listed URL
+		return make_uniq<NodeStatistics>(bind_data.max_results * MaxValue<idx_t>(bind_data.url_list.size(), 1));
+	}
 	return make_uniq<NodeStatistics>(bind_data.max_results);
 }
 
@@ -1389,6 +2148,15 @@ void OptimizeWaybackMachineLimitPushdown(unique_ptr<LogicalOperator> &op) {
 
 		auto &bind_data = get.bind_data->Cast<WaybackMachineBindData>();
 
+		if (bind_data.has_url_list) {
+			// URL lookups each run their own CDX query: any one URL may supply all of the first limit + offset
+			// rows, so each is capped there and the offset stays with TOP_N
+			bind_data.max_results = top_n.limit + top_n.offset;
+			bind_data.fast_latest = IsTimestampDescTopN(top_n, bind_data);
+			bind_data.order_desc = bind_data.fast_latest;
+			return;
+		}
+
 		// Check if ORDER BY timestamp DESC
 		if (IsTimestampDescTopN(top_n, bind_data)) {
 			bind_data.max_results = top_n.limit;
@@ -1460,6 +2228,14 @@ void OptimizeWaybackMachineLimitPushdown(unique_ptr<LogicalOperator> &op) {
 
 		// Extract limit value and store in bind_data
 		auto &bind_data = get.bind_data->Cast<WaybackMachineBindData>();
+		if (limit.limit_val.Type() == LimitNodeType::CONSTANT_VALUE && bind_data.has_url_list) {
+			// URL lookups: cap each URL's query at limit + offset and keep the LIMIT over their union
+			idx_t offset = has_constant_offset ? limit.offset_val.GetConstantValue() : 0;
+			if (has_constant_offset || limit.offset_val.Type() == LimitNodeType::UNSET) {
+				bind_data.max_results = limit.limit_val.GetConstantValue() + offset;
+			}
+			return;
+		}
 		if (limit.limit_val.Type() == LimitNodeType::CONSTANT_VALUE) {
 			bind_data.max_results = limit.limit_val.GetConstantValue();
 
@@ -1900,6 +2676,7 @@ void RegisterWaybackMachineFunction(ExtensionLoader &loader) {
 	// Register the wayback_machine table function
 	// Usage: SELECT * FROM wayback_machine() WHERE url = 'archive.org' LIMIT 10
 	// Usage with max_results: SELECT * FROM wayback_machine(max_results := 500) WHERE url = 'archive.org'
+	// Usage with a URL list: SELECT * FROM wayback_machine(urls := ['archive.org', 'example.com'])
 	// - URL filtering via WHERE clause
 	// - Supports matchType detection (exact, prefix, host, domain)
 	// - Much simpler than common_crawl - no WARC parsing needed
@@ -1907,8 +2684,10 @@ void RegisterWaybackMachineFunction(ExtensionLoader &loader) {
 	// - Optional max_results parameter controls CDX API result size (default: 100)
 	TableFunctionSet wayback_machine_set("wayback_machine");
 
-	auto ia_func = TableFunction({}, WaybackMachineScan, WaybackMachineBind, WaybackMachineInitGlobal);
+	auto ia_func =
+	    TableFunction({}, WaybackMachineScan, WaybackMachineBind, WaybackMachineInitGlobal, WaybackMachineInitLocal);
 	ia_func.cardinality = WaybackMachineCardinality;
+	ia_func.get_partition_data = WaybackMachineGetPartitionData;
 	ia_func.pushdown_complex_filter = WaybackMachinePushdownComplexFilter;
 	ia_func.projection_pushdown = true;
 
@@ -1917,6 +2696,8 @@ void RegisterWaybackMachineFunction(ExtensionLoader &loader) {
 	ia_func.named_parameters["collapse"] = LogicalType::VARCHAR;
 	ia_func.named_parameters["debug"] = LogicalType::BOOLEAN;
 	ia_func.named_parameters["timeout"] = LogicalType::BIGINT;
+	ia_func.named_parameters["prefetch"] = LogicalType::BIGINT;
+	ia_func.named_parameters["urls"] = LogicalType::LIST(LogicalType::VARCHAR);
 
 	wayback_machine_set.AddFunction(ia_func);
 
@@ -65,7 +65,8 @@ void D1Transaction::BufferStatement(const string &sql) {
 }
 
 D1QueryResult D1Transaction::ExecuteRead(const string &sql) {
-	// Reads are executed immediately, not buffered
+	// Reads are executed immediately, not buffered. They are not shared with reads in flight: the transaction must
+	// see its own session's earlier writes.
 	return D1ExecuteQuery(config, sql);
 }
 
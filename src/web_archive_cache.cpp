@@ -0,0 +1,382 @@
+#include "web_archive_cache.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "duckdb/logging/logger.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace duckdb {
+
+// ========================================
+// DISK CACHE
+// ========================================
+
+// Default cap for the whole cache directory
+static constexpr const char *DEFAULT_CACHE_MAX_SIZE = "4GB";
+// Wayback captures keep arriving, so cached Wayback CDX results go stale after a day by default
+static constexpr int64_t DEFAULT_WAYBACK_CDX_TTL_SECONDS = 24 * 60 * 60;
+// Default cap of the in-memory body cache
+static constexpr const char *DEFAULT_BODY_CACHE_SIZE = "256MB";
+// Suffix of entries that are still being written
+static constexpr const char *CACHE_TEMP_SUFFIX = ".tmp";
+// Subdirectories of web_archive_cache_dir that DiskCache::Get hands out
+static constexpr const char *CACHE_AREAS[] = {"content", "cdx", "collinfo", "bodies"};
+
+DiskCacheBudget::DiskCacheBudget(idx_t max_size_p) : max_size(max_size_p), total_size(0) {
+}
+
+void DiskCacheBudget::SetMaxSize(idx_t max_size_p) {
+	std::lock_guard<std::mutex> guard(lock);
+	max_size = max_size_p;
+}
+
+bool DiskCacheBudget::Contains(const string &path) {
+	std::lock_guard<std::mutex> guard(lock);
+	return entries.find(path) != entries.end();
+}
+
+void DiskCacheBudget::Touch(const string &path, idx_t size) {
+	std::lock_guard<std::mutex> guard(lock);
+	TouchLocked(path, size);
+}
+
+void DiskCacheBudget::TouchLocked(const string &path, idx_t size) {
+	auto existing = entries.find(path);
+	if (existing != entries.end()) {
+		total_size -= existing->second.size;
+		lru.erase(existing->second.lru_position);
+	}
+	lru.push_front(path);
+	Entry entry;
+	entry.size = size;
+	entry.lru_position = lru.begin();
+	entries[path] = entry;
+	total_size += size;
+}
+
+void DiskCacheBudget::Add(const string &path, idx_t size, vector<string> &to_remove) {
+	std::lock_guard<std::mutex> guard(lock);
+	TouchLocked(path, size);
+	// Keep the most recent entry even if it alone exceeds the cap
+	while (total_size > max_size && lru.size() > 1) {
+		auto &oldest = lru.back();
+		auto entry = entries.find(oldest);
+		total_size -= entry->second.size;
+		to_remove.push_back(oldest);
+		entries.erase(entry);
+		lru.pop_back();
+	}
+}
+
+DiskCache::DiskCache(string directory_p, shared_ptr<DiskCacheBudget> budget_p)
+    : directory(std::move(directory_p)), budget(std::move(budget_p)), fs(FileSystem::CreateLocal()) {
+}
+
+// Create path and any missing parent directories
+static void CreateDirectories(FileSystem &fs, string path) {
+	while (path.size() > 1 && (path.back() == '/' || path.back() == '\\')) {
+		path.pop_back();
+	}
+	if (path.empty() || fs.DirectoryExists(path)) {
+		return;
+	}
+	auto separator = path.find_last_of("/\\");
+	if (separator != string::npos && separator > 0) {
+		CreateDirectories(fs, path.substr(0, separator));
+	}
+	fs.CreateDirectory(path);
+}
+
+// Add the entries already in every area of cache_dir to a new budget, oldest first
+static void LoadCacheDirectory(FileSystem &fs, const string &cache_dir, DiskCacheBudget &budget) {
+	struct DiskEntry {
+		string path;
+		idx_t size;
+		timestamp_t modified;
+	};
+	vector<DiskEntry> found;
+	vector<string> stale;
+	// Only the areas this extension writes: anything else under cache_dir is never counted or evicted
+	for (auto area : CACHE_AREAS) {
+		auto area_dir = fs.JoinPath(cache_dir, area);
+		if (!fs.DirectoryExists(area_dir)) {
+			continue;
+		}
+		fs.ListFiles(area_dir, [&](const string &name, bool is_directory) {
+			if (is_directory) {
+				return;
+			}
+			auto path = fs.JoinPath(area_dir, name);
+			if (StringUtil::Contains(name, CACHE_TEMP_SUFFIX)) {
+				// Left behind by an interrupted write
+				stale.push_back(path);
+				return;
+			}
+			auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+			if (!handle) {
+				return;
+			}
+			DiskEntry entry;
+			entry.path = path;
+			entry.size = NumericCast<idx_t>(handle->GetFileSize());
+			entry.modified = fs.GetLastModifiedTime(*handle);
+			found.push_back(std::move(entry));
+		});
+	}
+	for (auto &path : stale) {
+		fs.TryRemoveFile(path);
+	}
+
+	// Without access times on disk, the last write is the best guess for recency
+	std::sort(found.begin(), found.end(),
+	          [](const DiskEntry &a, const DiskEntry &b) { return a.modified < b.modified; });
+	for (auto &entry : found) {
+		budget.Touch(entry.path, entry.size);
+	}
+}
+
+shared_ptr<DiskCache> DiskCache::Get(ClientContext &context, const string &area) {
+	Value dir_value;
+	if (!context.TryGetCurrentSetting(WEB_ARCHIVE_CACHE_DIR_SETTING, dir_value) || dir_value.IsNull()) {
+		return nullptr;
+	}
+	auto cache_dir = dir_value.ToString();
+	if (cache_dir.empty()) {
+		return nullptr;
+	}
+	idx_t max_size = DBConfig::ParseMemoryLimit(DEFAULT_CACHE_MAX_SIZE);
+	Value size_value;
+	if (context.TryGetCurrentSetting(WEB_ARCHIVE_CACHE_MAX_SIZE_SETTING, size_value) && !size_value.IsNull()) {
+		max_size = DBConfig::ParseMemoryLimit(size_value.ToString());
+	}
+
+	// One instance per area and one budget per cache directory, shared by all queries so the LRU order is
+	// process-wide
+	static std::mutex registry_lock;
+	static std::unordered_map<string, shared_ptr<DiskCache>> registry;
+	static std::unordered_map<string, shared_ptr<DiskCacheBudget>> budgets;
+
+	auto local_fs = FileSystem::CreateLocal();
+	auto area_dir = local_fs->JoinPath(cache_dir, area);
+
+	std::lock_guard<std::mutex> guard(registry_lock);
+	auto &budget = budgets[cache_dir];
+	if (budget) {
+		budget->SetMaxSize(max_size);
+	}
+	auto entry = registry.find(area_dir);
+	if (entry != registry.end()) {
+		return entry->second;
+	}
+	try {
+		CreateDirectories(*local_fs, area_dir);
+		if (!budget) {
+			budget = make_shared_ptr<DiskCacheBudget>(max_size);
+			LoadCacheDirectory(*local_fs, cache_dir, *budget);
+		}
+	} catch (std::exception &ex) {
+		// The cache is best effort: a directory that cannot be created disables it instead of failing the query
+		DUCKDB_LOG_DEBUG(context, "Not caching in %s: %s", area_dir.c_str(), ex.what());
+		budget = nullptr;
+		return nullptr;
+	}
+	auto cache = make_shared_ptr<DiskCache>(area_dir, budget);
+	registry[area_dir] = cache;
+	return cache;
+}
+
+string DiskCache::EntryFileName(const string &key) {
+	return StringUtil::Format("%016llx", (unsigned long long)Hash(key.c_str(), key.size()));
+}
+
+string DiskCache::EntryPath(const string &file_name) const {
+	return fs->JoinPath(directory, file_name);
+}
+
+bool DiskCache::Read(const string &key, string &out, int64_t max_age_seconds) {
+	auto path = EntryPath(EntryFileName(key));
+	if (!budget->Contains(path)) {
+		return false;
+	}
+
+	string contents;
+	try {
+		auto handle = fs->OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+		if (!handle) {
+			return false;
+		}
+		if (max_age_seconds >= 0) {
+			auto age_us = Timestamp::GetCurrentTimestamp().value - fs->GetLastModifiedTime(*handle).value;
+			if (age_us > max_age_seconds * Interval::MICROS_PER_SEC) {
+				return false;
+			}
+		}
+		auto file_size = NumericCast<idx_t>(handle->GetFileSize());
+		contents.resize(file_size);
+		idx_t total_read = 0;
+		while (total_read < file_size) {
+			auto bytes_read = handle->Read(&contents[total_read], file_size - total_read);
+			if (bytes_read <= 0) {
+				return false;
+			}
+			total_read += NumericCast<idx_t>(bytes_read);
+		}
+	} catch (std::exception &) {
+		// Entry was evicted or replaced while we read it
+		return false;
+	}
+
+	// First line holds the full key: a different key means a hash collision
+	auto newline = contents.find('\n');
+	if (newline == string::npos || contents.compare(0, newline, key) != 0) {
+		return false;
+	}
+	out = contents.substr(newline + 1);
+
+	budget->Touch(path, contents.size());
+	return true;
+}
+
+void DiskCache::Write(const string &key, const char *data, idx_t size) {
+	static std::atomic<idx_t> temp_counter(0);
+	auto final_path = EntryPath(EntryFileName(key));
+	auto temp_path = final_path + CACHE_TEMP_SUFFIX + to_string(temp_counter++);
+
+	try {
+		auto handle = fs->OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		string header = key + "\n";
+		handle->Write((void *)header.data(), header.size());
+		handle->Write((void *)data, size);
+		handle->Close();
+		fs->MoveFile(temp_path, final_path);
+	} catch (std::exception &) {
+		// The cache is best effort: a full or read-only disk must not fail the query
+		fs->TryRemoveFile(temp_path);
+		return;
+	}
+
+	vector<string> to_remove;
+	budget->Add(final_path, key.size() + 1 + size, to_remove);
+	for (auto &path : to_remove) {
+		fs->TryRemoveFile(path);
+	}
+}
+
+// ========================================
+// BODY CACHE
+// ========================================
+
+BodyCache::BodyCache(idx_t max_size_p) : max_size(max_size_p), total_size(0) {
+}
+
+shared_ptr<BodyCache> BodyCache::Get(ClientContext &context) {
+	idx_t max_size = DBConfig::ParseMemoryLimit(DEFAULT_BODY_CACHE_SIZE);
+	Value size_value;
+	if (context.TryGetCurrentSetting(WEB_ARCHIVE_BODY_CACHE_SIZE_SETTING, size_value) && !size_value.IsNull()) {
+		max_size = DBConfig::ParseMemoryLimit(size_value.ToString());
+	}
+	if (max_size == 0) {
+		return nullptr;
+	}
+
+	// One instance shared by all queries, so the LRU order is process-wide; the latest setting decides its cap
+	static shared_ptr<BodyCache> cache = make_shared_ptr<BodyCache>(max_size);
+	std::lock_guard<std::mutex> guard(cache->lock);
+	if (cache->max_size != max_size) {
+		cache->max_size = max_size;
+		cache->EvictLocked();
+	}
+	return cache;
+}
+
+shared_ptr<string> BodyCache::Read(const string &key, DiskCache *disk) {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto entry = entries.find(key);
+		if (entry != entries.end()) {
+			lru.splice(lru.begin(), lru, entry->second.lru_position);
+			return entry->second.body;
+		}
+	}
+	string stored;
+	if (!disk || !disk->Read(key, stored)) {
+		return nullptr;
+	}
+	auto body = make_shared_ptr<string>(std::move(stored));
+	std::lock_guard<std::mutex> guard(lock);
+	if (body->size() <= max_size / 4) {
+		InsertLocked(key, body);
+	}
+	return body;
+}
+
+void BodyCache::Write(const string &key, shared_ptr<string> body, DiskCache *disk) {
+	if (disk) {
+		disk->Write(key, body->data(), body->size());
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	if (body->size() <= max_size / 4) {
+		InsertLocked(key, std::move(body));
+	}
+}
+
+void BodyCache::InsertLocked(const string &key, shared_ptr<string> body) {
+	auto entry = entries.find(key);
+	if (entry != entries.end()) {
+		total_size -= entry->second.body->size();
+		lru.erase(entry->second.lru_position);
+		entries.erase(entry);
+	}
+	lru.push_front(key);
+	total_size += body->size();
+	entries[key] = Entry {std::move(body), lru.begin()};
+	EvictLocked();
+}
+
+void BodyCache::EvictLocked() {
+	while (total_size > max_size && !lru.empty()) {
+		auto entry = entries.find(lru.back());
+		total_size -= entry->second.body->size();
+		entries.erase(entry);
+		lru.pop_back();
+	}
+}
+
+// ========================================
+// SETTINGS
+// ========================================
+
+int64_t GetWaybackCDXCacheTTL(ClientContext &context) {
+	Value ttl_value;
+	if (!context.TryGetCurrentSetting(WEB_ARCHIVE_WAYBACK_CDX_TTL_SETTING, ttl_value) || ttl_value.IsNull()) {
+		return DEFAULT_WAYBACK_CDX_TTL_SECONDS;
+	}
+	return MaxValue<int64_t>(ttl_value.GetValue<int64_t>(), 0);
+}
+
+static void ValidateCacheMaxSize(ClientContext &context, SetScope scope, Value &parameter) {
+	// Throws for sizes DuckDB cannot parse (e.g. '12 parsecs')
+	DBConfig::ParseMemoryLimit(parameter.ToString());
+}
+
+void RegisterWebArchiveCacheSettings(DBConfig &config) {
+	config.AddExtensionOption(WEB_ARCHIVE_CACHE_DIR_SETTING,
+	                          "Directory for cached WARC records and archived pages (empty disables the cache)",
+	                          LogicalType::VARCHAR, Value(""));
+	config.AddExtensionOption(WEB_ARCHIVE_CACHE_MAX_SIZE_SETTING,
+	                          "Maximum size of web_archive_cache_dir, all cache areas together, e.g. '4GB'",
+	                          LogicalType::VARCHAR, Value(DEFAULT_CACHE_MAX_SIZE), ValidateCacheMaxSize);
+	config.AddExtensionOption(WEB_ARCHIVE_WAYBACK_CDX_TTL_SETTING,
+	                          "Seconds cached Wayback CDX results stay valid (0 disables caching them)",
+	                          LogicalType::BIGINT, Value::BIGINT(DEFAULT_WAYBACK_CDX_TTL_SECONDS));
+	config.AddExtensionOption(WEB_ARCHIVE_BODY_CACHE_SIZE_SETTING,
+	                          "Memory for response bodies reused across captures with the same digest ('0' disables)",
+	                          LogicalType::VARCHAR, Value(DEFAULT_BODY_CACHE_SIZE), ValidateCacheMaxSize);
+}
+
+} // namespace duckdb
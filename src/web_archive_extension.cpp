@@ -2,7 +2,7 @@
 
 #include "web_archive_extension.hpp"
 #include "web_archive_utils.hpp"
-#include "d1_extension.hpp"
+#include "web_archive_cache.hpp"
 #include "duckdb.hpp"
 #include "duckdb/main/config.hpp"
 
@@ -21,7 +21,6 @@ void CommonCrawlOptimizer(OptimizerExtensionInput &input, unique_ptr<LogicalOper
 	OptimizeCommonCrawlLimitPushdown(plan);
 	OptimizeWaybackMachineLimitPushdown(plan);
 	OptimizeWaybackMachineDistinctOnPushdown(plan);
-	OptimizeD1ScanLimitPushdown(plan);
 }
 
 static void LoadInternal(ExtensionLoader &loader) {
@@ -35,23 +34,14 @@ static void LoadInternal(ExtensionLoader &loader) {
 	// Register the wayback_machine table function
 	RegisterWaybackMachineFunction(loader);
 
-	// Register Cloudflare D1 functions
-	RegisterD1QueryFunction(loader);
-	RegisterD1DatabasesFunction(loader);
-	RegisterD1TablesFunction(loader);
-	RegisterD1ExecuteFunction(loader);
+	// The D1 functions are registered by the cloudflare extension
 
-	// Register D1 secret type for CREATE SECRET TYPE D1
-	RegisterD1SecretType(loader);
-
-	// Register D1 storage extension for ATTACH DATABASE syntax
-	RegisterD1StorageExtension(loader.GetDatabaseInstance());
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
 
-	// Register d1_scan table function
-	RegisterD1ScanFunction(loader);
+	// Register web_archive_cache_dir / web_archive_cache_max_size settings
+	RegisterWebArchiveCacheSettings(config);
 
 	// Register optimizer extension for LIMIT pushdown
-	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
 	OptimizerExtension optimizer;
 	optimizer.optimize_function = CommonCrawlOptimizer;
 	config.optimizer_extensions.push_back(std::move(optimizer));
@@ -0,0 +1,236 @@
+#include "web_archive_fetch.hpp"
+#include <algorithm>
+#include <random>
+
+namespace duckdb {
+
+// ========================================
+// FETCH EXECUTOR
+// ========================================
+
+// Worker threads shared by all web archive scans
+static constexpr idx_t FETCH_WORKER_COUNT = 32;
+// Maximum number of queued (not yet running) fetches
+static constexpr idx_t FETCH_QUEUE_CAPACITY = 256;
+// Default cap for hosts without a specific limit
+static constexpr idx_t DEFAULT_HOST_CONCURRENCY = 8;
+// A host's limit may grow up to this multiple of its starting limit
+static constexpr idx_t HOST_CONCURRENCY_CEILING_FACTOR = 2;
+// Multiplicative decrease on 429/503; a burst of throttled responses from one window only cuts once
+static constexpr double HOST_DECREASE_FACTOR = 0.5;
+static constexpr std::chrono::milliseconds HOST_DECREASE_INTERVAL(1000);
+// Longest Retry-After honoured; larger values are capped rather than stalling the scan
+static constexpr int MAX_RETRY_AFTER_SECONDS = 60;
+// Successful request latencies kept per host for the p95
+static constexpr idx_t LATENCY_WINDOW = 128;
+// Samples needed before a host's p95 is trusted for hedging
+static constexpr idx_t HEDGE_MIN_SAMPLES = 20;
+// Never hedge sooner than this, however fast the host usually is
+static constexpr double HEDGE_MIN_DELAY_MS = 50;
+// No hedging for this long after the host throttled us: duplicates would only add load
+static constexpr std::chrono::seconds HEDGE_QUIET_PERIOD(10);
+// At most one hedge per this many slots of the host's current limit (and at least one)
+static constexpr idx_t HEDGE_SLOTS_PER_HEDGE = 4;
+
+FetchExecutor &FetchExecutor::Get() {
+	// Intentionally leaked: worker threads must outlive every query and are torn down with the process
+	static FetchExecutor *executor = new FetchExecutor(FETCH_WORKER_COUNT, FETCH_QUEUE_CAPACITY);
+	return *executor;
+}
+
+idx_t FetchExecutor::HostConcurrencyLimit(const string &host) {
+	// data.commoncrawl.org is served from S3/CloudFront and tolerates more parallel range requests
+	if (host == "data.commoncrawl.org") {
+		return 16;
+	}
+	// The CDX index server is shared by everyone and rate limits aggressively
+	if (host == "index.commoncrawl.org") {
+		return 4;
+	}
+	// web.archive.org starts returning 429/503 quickly under load
+	if (host == "web.archive.org") {
+		return 6;
+	}
+	return DEFAULT_HOST_CONCURRENCY;
+}
+
+FetchExecutor::FetchExecutor(idx_t worker_count, idx_t queue_capacity_p) : queue_capacity(queue_capacity_p) {
+	for (idx_t i = 0; i < worker_count; i++) {
+		std::thread worker([this]() { WorkerLoop(); });
+		worker.detach();
+	}
+}
+
+void FetchExecutor::Submit(const string &host, std::function<void()> task) {
+	std::unique_lock<std::mutex> guard(lock);
+	space_available.wait(guard, [this]() { return queue.size() < queue_capacity; });
+	QueuedTask entry;
+	entry.host = host;
+	entry.task = std::move(task);
+	queue.push_back(std::move(entry));
+	work_available.notify_one();
+}
+
+void FetchExecutor::SubmitDelayed(const string &host, double delay_ms, std::function<void()> task,
+                                  std::shared_ptr<std::atomic<bool>> superseded) {
+	std::lock_guard<std::mutex> guard(lock);
+	QueuedTask entry;
+	entry.host = host;
+	entry.task = std::move(task);
+	entry.superseded = std::move(superseded);
+	entry.not_before = std::chrono::steady_clock::now() +
+	                   std::chrono::microseconds(static_cast<int64_t>(delay_ms * 1000));
+	// Hedges are bounded per host and called from workers, so they skip the capacity wait that could deadlock
+	queue.push_front(std::move(entry));
+	// A worker may be waiting without a deadline; have it pick up the new wake-up time
+	work_available.notify_one();
+}
+
+FetchExecutor::HostState &FetchExecutor::GetHostState(const string &host) {
+	auto &state = hosts[host];
+	if (state.ceiling == 0) {
+		state.limit = static_cast<double>(HostConcurrencyLimit(host));
+		state.ceiling = HostConcurrencyLimit(host) * HOST_CONCURRENCY_CEILING_FACTOR;
+	}
+	return state;
+}
+
+bool FetchExecutor::TryPopRunnable(QueuedTask &out, time_point_t &wake_at) {
+	auto now = std::chrono::steady_clock::now();
+	for (auto it = queue.begin(); it != queue.end(); ++it) {
+		if (it->superseded && it->superseded->load()) {
+			out = std::move(*it);
+			queue.erase(it);
+			GetHostState(out.host).active++;
+			return true;
+		}
+		if (it->not_before > now) {
+			wake_at = MinValue(wake_at, it->not_before);
+			continue;
+		}
+		auto &state = GetHostState(it->host);
+		if (state.paused_until > now) {
+			wake_at = MinValue(wake_at, state.paused_until);
+			continue;
+		}
+		if (state.active >= static_cast<idx_t>(state.limit)) {
+			continue;
+		}
+		out = std::move(*it);
+		queue.erase(it);
+		state.active++;
+		return true;
+	}
+	return false;
+}
+
+void FetchExecutor::WorkerLoop() {
+	while (true) {
+		QueuedTask entry;
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			while (true) {
+				auto wake_at = time_point_t::max();
+				if (TryPopRunnable(entry, wake_at)) {
+					break;
+				}
+				if (wake_at == time_point_t::max()) {
+					work_available.wait(guard);
+				} else {
+					work_available.wait_until(guard, wake_at);
+				}
+			}
+		}
+		space_available.notify_one();
+
+		try {
+			entry.task();
+		} catch (...) {
+			// Tasks report failures through their own result; never let one take down a worker
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			hosts[entry.host].active--;
+		}
+		// A slot for this host opened up - queued tasks for it may now be runnable
+		work_available.notify_all();
+	}
+}
+
+// ========================================
+// HOST CONCURRENCY CONTROL
+// ========================================
+
+void FetchExecutor::RecordResponse(const string &host, long status, int retry_after_seconds, double latency_ms) {
+	bool grew = false;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		auto &state = GetHostState(host);
+		auto now = std::chrono::steady_clock::now();
+		if (status == 429 || status == 503) {
+			if (now - state.last_decrease >= HOST_DECREASE_INTERVAL) {
+				state.limit = MaxValue<double>(1, state.limit * HOST_DECREASE_FACTOR);
+				state.last_decrease = now;
+			}
+			if (retry_after_seconds > 0) {
+				auto pause = std::chrono::seconds(MinValue<int>(retry_after_seconds, MAX_RETRY_AFTER_SECONDS));
+				state.paused_until = MaxValue<time_point_t>(state.paused_until, now + pause);
+			}
+		} else if (status >= 200 && status < 300) {
+			// Additive increase: one slot per limit's worth of successes
+			auto before = static_cast<idx_t>(state.limit);
+			state.limit = MinValue<double>(static_cast<double>(state.ceiling), state.limit + 1 / state.limit);
+			grew = static_cast<idx_t>(state.limit) > before;
+			if (state.latencies_ms.size() < LATENCY_WINDOW) {
+				state.latencies_ms.push_back(latency_ms);
+			} else {
+				state.latencies_ms[state.next_latency] = latency_ms;
+			}
+			state.next_latency = (state.next_latency + 1) % LATENCY_WINDOW;
+		}
+	}
+	if (grew) {
+		work_available.notify_all();
+	}
+}
+
+int FetchExecutor::RetryDelayMs(const string &host, int backoff_ms) {
+	// Jitter spreads out the retries of fetches that failed together
+	static thread_local std::minstd_rand random(std::random_device {}());
+	std::uniform_int_distribution<int> jitter(backoff_ms / 2, backoff_ms);
+	int delay_ms = jitter(random);
+
+	std::lock_guard<std::mutex> guard(lock);
+	auto &state = GetHostState(host);
+	auto paused_ms =
+	    std::chrono::duration_cast<std::chrono::milliseconds>(state.paused_until - std::chrono::steady_clock::now());
+	return MaxValue<int>(delay_ms, static_cast<int>(paused_ms.count()));
+}
+
+bool FetchExecutor::TryReserveHedge(const string &host, double &delay_ms) {
+	std::lock_guard<std::mutex> guard(lock);
+	auto &state = GetHostState(host);
+	auto now = std::chrono::steady_clock::now();
+	if (state.latencies_ms.size() < HEDGE_MIN_SAMPLES || state.paused_until > now ||
+	    now - state.last_decrease < HEDGE_QUIET_PERIOD) {
+		return false;
+	}
+	auto max_hedges = MaxValue<idx_t>(1, static_cast<idx_t>(state.limit) / HEDGE_SLOTS_PER_HEDGE);
+	if (state.hedges >= max_hedges) {
+		return false;
+	}
+	vector<double> latencies = state.latencies_ms;
+	auto p95 = latencies.begin() + (latencies.size() * 95) / 100;
+	std::nth_element(latencies.begin(), p95, latencies.end());
+	delay_ms = MaxValue<double>(*p95, HEDGE_MIN_DELAY_MS);
+	state.hedges++;
+	return true;
+}
+
+void FetchExecutor::ReleaseHedge(const string &host) {
+	std::lock_guard<std::mutex> guard(lock);
+	hosts[host].hedges--;
+}
+
+} // namespace duckdb
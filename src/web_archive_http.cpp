@@ -0,0 +1,282 @@
+#include "web_archive_http.hpp"
+#include <curl/curl.h>
+#include <cstring>
+#include <mutex>
+
+namespace duckdb {
+
+// ========================================
+// CURL CALLBACKS
+// ========================================
+
+// Destination of a ranged GET: a fixed-size buffer owned by the caller
+struct RangeSink {
+	char *buffer;
+	idx_t capacity;
+	idx_t size;
+	bool overflow; // Server sent more than requested (e.g. ignored the Range header)
+	int retry_after;
+};
+
+// Destination of a whole-body GET
+struct BodySink {
+	string *body;
+	int retry_after;
+};
+
+// Destination of a streamed GET
+struct StreamSink {
+	CURL *curl;
+	const std::function<bool(const char *data, idx_t size)> *on_data;
+	bool stopped; // on_data asked to end the transfer
+	int retry_after;
+};
+
+// Callback for libcurl to copy response data into the pre-sized buffer
+static size_t RangeWriteCallback(void *contents, size_t size, size_t nmemb, void *userp) {
+	auto sink = static_cast<RangeSink *>(userp);
+	idx_t incoming = size * nmemb;
+	if (sink->size + incoming > sink->capacity) {
+		// Abort the transfer instead of downloading the whole file
+		sink->overflow = true;
+		return 0;
+	}
+	memcpy(sink->buffer + sink->size, contents, incoming);
+	sink->size += incoming;
+	return incoming;
+}
+
+// Callback for libcurl to append response data to a string
+static size_t BodyWriteCallback(void *contents, size_t size, size_t nmemb, void *userp) {
+	auto sink = static_cast<BodySink *>(userp);
+	idx_t incoming = size * nmemb;
+	sink->body->append(static_cast<const char *>(contents), incoming);
+	return incoming;
+}
+
+// Callback for libcurl to pass response data on; error bodies are dropped
+static size_t StreamWriteCallback(void *contents, size_t size, size_t nmemb, void *userp) {
+	auto sink = static_cast<StreamSink *>(userp);
+	idx_t incoming = size * nmemb;
+	long status = 0;
+	curl_easy_getinfo(sink->curl, CURLINFO_RESPONSE_CODE, &status);
+	if (status < 200 || status >= 300) {
+		return incoming;
+	}
+	if (!(*sink->on_data)(static_cast<const char *>(contents), incoming)) {
+		sink->stopped = true;
+		return 0;
+	}
+	return incoming;
+}
+
+// Callback for libcurl to pick up the Retry-After header (seconds form only); userp points at the sink's retry_after
+static size_t RetryAfterHeaderCallback(char *data, size_t size, size_t nitems, void *userp) {
+	auto retry_after = static_cast<int *>(userp);
+	idx_t length = size * nitems;
+	static const char RETRY_AFTER[] = "retry-after:";
+	idx_t prefix_length = sizeof(RETRY_AFTER) - 1;
+	if (length > prefix_length && strncasecmp(data, RETRY_AFTER, prefix_length) == 0) {
+		string value(data + prefix_length, length - prefix_length);
+		try {
+			*retry_after = std::stoi(value);
+		} catch (...) {
+			// HTTP-date form - ignore and let the caller use its own backoff
+		}
+	}
+	return length;
+}
+
+// ========================================
+// RANGE HTTP CLIENT
+// ========================================
+
+RangeHttpClient::RangeHttpClient() {
+	// curl_global_init is not thread-safe; run it once before the first handle is created
+	static std::once_flag curl_initialized;
+	std::call_once(curl_initialized, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+	handle = curl_easy_init();
+}
+
+RangeHttpClient::~RangeHttpClient() {
+	if (handle) {
+		curl_easy_cleanup(static_cast<CURL *>(handle));
+	}
+}
+
+RangeHttpClient &RangeHttpClient::ThreadLocal() {
+	static thread_local RangeHttpClient client;
+	return client;
+}
+
+RangeResponse RangeHttpClient::GetRange(const string &url, idx_t offset, idx_t length, char *buffer,
+                                        int timeout_seconds) {
+	RangeResponse result;
+	auto curl = static_cast<CURL *>(handle);
+	if (!curl) {
+		result.transport_error = true;
+		result.error = "Failed to initialize curl";
+		return result;
+	}
+
+	RangeSink sink;
+	sink.buffer = buffer;
+	sink.capacity = length;
+	sink.size = 0;
+	sink.overflow = false;
+	sink.retry_after = -1;
+
+	// Reset per-request options but keep the connection cache of the handle
+	curl_easy_reset(curl);
+	curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+
+	// Exactly the bytes of the record
+	string range = to_string(offset) + "-" + to_string(offset + length - 1);
+	curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, RangeWriteCallback);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
+	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, RetryAfterHeaderCallback);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, &sink.retry_after);
+
+	// SSL verification
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+	curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(timeout_seconds));
+
+	CURLcode res = curl_easy_perform(curl);
+	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &result.status);
+	double total_seconds = 0;
+	curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total_seconds);
+	result.latency_ms = total_seconds * 1000;
+	result.retry_after = sink.retry_after;
+	result.bytes_read = sink.size;
+
+	if (sink.overflow) {
+		result.error = "Server returned more than the requested " + to_string(length) + " bytes (status " +
+		               to_string(result.status) + ")";
+		return result;
+	}
+	if (res != CURLE_OK) {
+		result.transport_error = true;
+		result.error = "HTTP request failed: " + string(curl_easy_strerror(res));
+		return result;
+	}
+	if (result.status != 206 && !(result.status == 200 && offset == 0)) {
+		result.error = "HTTP " + to_string(result.status) + " for range " + range + " of " + url;
+		return result;
+	}
+	return result;
+}
+
+RangeResponse RangeHttpClient::Get(const string &url, string &body, int timeout_seconds) {
+	RangeResponse result;
+	body.clear();
+	auto curl = static_cast<CURL *>(handle);
+	if (!curl) {
+		result.transport_error = true;
+		result.error = "Failed to initialize curl";
+		return result;
+	}
+
+	BodySink sink;
+	sink.body = &body;
+	sink.retry_after = -1;
+
+	curl_easy_reset(curl);
+	curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, BodyWriteCallback);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
+	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, RetryAfterHeaderCallback);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, &sink.retry_after);
+
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+	curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(timeout_seconds));
+
+	CURLcode res = curl_easy_perform(curl);
+	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &result.status);
+	double total_seconds = 0;
+	curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total_seconds);
+	result.latency_ms = total_seconds * 1000;
+	result.retry_after = sink.retry_after;
+	result.bytes_read = body.size();
+
+	if (res != CURLE_OK) {
+		result.transport_error = true;
+		result.error = "HTTP request failed: " + string(curl_easy_strerror(res));
+		body.clear();
+		return result;
+	}
+	if (result.status < 200 || result.status >= 300) {
+		result.error = "HTTP " + to_string(result.status) + " for " + url;
+		body.clear();
+		return result;
+	}
+	return result;
+}
+
+RangeResponse RangeHttpClient::Stream(const string &url,
+                                      const std::function<bool(const char *data, idx_t size)> &on_data,
+                                      int timeout_seconds) {
+	RangeResponse result;
+	auto curl = static_cast<CURL *>(handle);
+	if (!curl) {
+		result.transport_error = true;
+		result.error = "Failed to initialize curl";
+		return result;
+	}
+
+	StreamSink sink;
+	sink.curl = curl;
+	sink.on_data = &on_data;
+	sink.stopped = false;
+	sink.retry_after = -1;
+
+	curl_easy_reset(curl);
+	curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, StreamWriteCallback);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &sink);
+	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, RetryAfterHeaderCallback);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, &sink.retry_after);
+
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+	curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+	curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(timeout_seconds));
+
+	CURLcode res = curl_easy_perform(curl);
+	curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &result.status);
+	double total_seconds = 0;
+	curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total_seconds);
+	result.latency_ms = total_seconds * 1000;
+	result.retry_after = sink.retry_after;
+
+	if (sink.stopped) {
+		return result;
+	}
+	if (res != CURLE_OK) {
+		// A URL curl cannot even parse fails the same way every time
+		result.transport_error = res != CURLE_URL_MALFORMAT;
+		result.error = "HTTP request failed: " + string(curl_easy_strerror(res));
+		return result;
+	}
+	if (result.status < 200 || result.status >= 300) {
+		result.error = "HTTP " + to_string(result.status) + " for " + url;
+		return result;
+	}
+	return result;
+}
+
+} // namespace duckdb
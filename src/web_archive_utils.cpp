@@ -1,7 +1,15 @@
 #include "web_archive_utils.hpp"
+#include "web_archive_cache.hpp"
+#include "web_archive_fetch.hpp"
+#include "web_archive_utf8.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/connection.hpp"
 #include "duckdb/logging/logger.hpp"
+#include "duckdb/common/types/vector_buffer.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
 
 namespace duckdb {
 
@@ -10,7 +18,6 @@ namespace duckdb {
 // ========================================
 
 std::chrono::steady_clock::time_point g_start_time;
-CollInfoCache g_collinfo_cache;
 
 // ========================================
 // TIMING UTILITIES
@@ -88,65 +95,38 @@ string ToCdxTimestamp(const string &ts_str) {
 	return digits;
 }
 
-string SanitizeUTF8(const string &str) {
+// Copy data replacing every byte that does not start a well-formed sequence with '?'
+static string RepairUTF8(const char *data, idx_t length) {
+	auto bytes = reinterpret_cast<const unsigned char *>(data);
 	string result;
-	result.reserve(str.size());
-
-	for (size_t i = 0; i < str.size();) {
-		unsigned char c = static_cast<unsigned char>(str[i]);
-
-		// ASCII character (0-127)
-		if (c < 0x80) {
-			result += c;
-			i++;
-			continue;
-		}
-
-		// Multi-byte UTF-8 character
-		int len = 0;
-		if ((c & 0xE0) == 0xC0)
-			len = 2; // 2-byte
-		else if ((c & 0xF0) == 0xE0)
-			len = 3; // 3-byte
-		else if ((c & 0xF8) == 0xF0)
-			len = 4; // 4-byte
-		else {
-			// Invalid start byte, replace with ?
-			result += '?';
-			i++;
-			continue;
-		}
-
-		// Check if we have enough bytes
-		if (i + len > str.size()) {
-			// Truncated sequence, replace with ?
-			result += '?';
+	result.reserve(length);
+	idx_t i = 0;
+	while (i < length) {
+		auto ascii_end = SkipASCII(data, length, i);
+		result.append(data + i, ascii_end - i);
+		i = ascii_end;
+		if (i == length) {
 			break;
 		}
-
-		// Validate continuation bytes
-		bool valid = true;
-		for (int j = 1; j < len; j++) {
-			if ((static_cast<unsigned char>(str[i + j]) & 0xC0) != 0x80) {
-				valid = false;
-				break;
-			}
-		}
-
-		if (valid) {
-			// Add the valid multi-byte sequence
-			result.append(str, i, len);
-			i += len;
-		} else {
-			// Invalid sequence, replace with ?
+		auto len = UTF8SequenceLength(bytes + i, length - i);
+		if (len == 0) {
 			result += '?';
 			i++;
+			continue;
 		}
+		result.append(data + i, len);
+		i += len;
 	}
-
 	return result;
 }
 
+string SanitizeUTF8(const string &str) {
+	if (IsValidUTF8(str.data(), str.size())) {
+		return str;
+	}
+	return RepairUTF8(str.data(), str.size());
+}
+
 Value SafeStringValue(const string &str) {
 	try {
 		string sanitized = SanitizeUTF8(str);
@@ -218,204 +198,763 @@ timestamp_t ParseCDXTimestamp(const string &cdx_timestamp) {
 	}
 }
 
+string GetUrlHost(const string &url) {
+	size_t host_start = url.find("://");
+	host_start = host_start == string::npos ? 0 : host_start + 3;
+	size_t host_end = url.find_first_of(":/?#", host_start);
+	if (host_end == string::npos) {
+		host_end = url.size();
+	}
+	return url.substr(host_start, host_end - host_start);
+}
+
 // ========================================
 // GZIP DECOMPRESSION
 // ========================================
 
-string DecompressGzip(const char *compressed_data, size_t compressed_size) {
-	// Initialize zlib stream
-	z_stream stream;
-	memset(&stream, 0, sizeof(stream));
+// One zlib inflate state per worker thread, reset between records instead of re-allocating its 32 KB window
+class GzipInflater {
+public:
+	GzipInflater() : initialized(false) {
+		memset(&stream, 0, sizeof(stream));
+	}
+	~GzipInflater() {
+		if (initialized) {
+			inflateEnd(&stream);
+		}
+	}
 
-	// Initialize for gzip decompression (windowBits = 15 + 16 for gzip format)
-	int ret = inflateInit2(&stream, 15 + 16);
-	if (ret != Z_OK) {
-		return "[Error: Failed to initialize gzip decompression]";
+	// Returns nullptr when zlib could not allocate its state
+	z_stream *Begin(const char *compressed_data, size_t compressed_size) {
+		if (!initialized) {
+			// windowBits = 15 + 16 for gzip format
+			if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+				return nullptr;
+			}
+			initialized = true;
+		} else if (inflateReset(&stream) != Z_OK) {
+			return nullptr;
+		}
+		stream.avail_in = NumericCast<uInt>(compressed_size);
+		stream.next_in = (Bytef *)compressed_data;
+		return &stream;
 	}
 
-	// Set input
-	stream.avail_in = compressed_size;
-	stream.next_in = (Bytef *)compressed_data;
+private:
+	z_stream stream;
+	bool initialized;
+};
 
-	// Prepare output buffer (estimate 10x compression ratio)
-	std::vector<char> decompressed_buffer;
-	decompressed_buffer.reserve(compressed_size * 10);
+static GzipInflater &GetThreadInflater() {
+	static thread_local GzipInflater inflater;
+	return inflater;
+}
 
-	// Decompress in chunks
-	const size_t chunk_size = 32768; // 32 KB chunks
-	char out_buffer[chunk_size];
+// Output chunk used while nothing better is known about the inflated size
+static constexpr idx_t GZIP_MIN_OUTPUT_CHUNK = 32768;
+// DEFLATE cannot expand data by more than ~1032x, which bounds a corrupt or multi-member ISIZE
+static constexpr idx_t GZIP_MAX_RATIO = 1032;
+// ISIZE comes from an untrusted trailer: larger outputs are reached by growing the buffer as they inflate
+static constexpr idx_t GZIP_MAX_SIZE_HINT = 64ULL * 1024 * 1024;
+// Most output offered to one inflate call; a resize zero-fills the step before inflate overwrites it
+static constexpr idx_t GZIP_MAX_OUTPUT_STEP = 4ULL * 1024 * 1024;
+
+// Inflated size of a complete single-member gzip stream, from its ISIZE trailer (size mod 2^32)
+static idx_t GzipInflatedSizeHint(const char *compressed_data, size_t compressed_size) {
+	if (compressed_size < 18 || (uint8_t)compressed_data[0] != 0x1f || (uint8_t)compressed_data[1] != 0x8b) {
+		return GZIP_MIN_OUTPUT_CHUNK;
+	}
+	auto trailer = (const uint8_t *)compressed_data + compressed_size - 4;
+	idx_t isize = idx_t(trailer[0]) | (idx_t(trailer[1]) << 8) | (idx_t(trailer[2]) << 16) | (idx_t(trailer[3]) << 24);
+	auto hint = MinValue<idx_t>(MinValue<idx_t>(isize, compressed_size * GZIP_MAX_RATIO), GZIP_MAX_SIZE_HINT);
+	return MaxValue<idx_t>(hint, GZIP_MIN_OUTPUT_CHUNK);
+}
 
+// Inflate straight into out's storage, which keeps its geometric growth; out holds exactly the inflated bytes
+// between steps. Each step offers the spare capacity, at most max_step and at least one chunk.
+// With stop, inflation ends early once stop(out) holds. Spare capacity left by a size hint that was too large is
+// released. Returns the last zlib status.
+static int InflateInto(z_stream &stream, string &out, idx_t size_hint, idx_t max_step,
+                       const std::function<bool(const string &out)> *stop) {
+	out.clear();
+	out.reserve(size_hint);
+	int ret;
 	do {
-		stream.avail_out = chunk_size;
-		stream.next_out = (Bytef *)out_buffer;
-
+		auto produced = out.size();
+		auto step = MaxValue<idx_t>(MinValue<idx_t>(out.capacity() - produced, max_step), GZIP_MIN_OUTPUT_CHUNK);
+		out.resize(produced + step);
+		stream.avail_out = NumericCast<uInt>(step);
+		stream.next_out = (Bytef *)&out[produced];
 		ret = inflate(&stream, Z_NO_FLUSH);
+		out.resize(produced + step - stream.avail_out);
+	} while (ret == Z_OK && !(stop && (*stop)(out)));
+	if (out.capacity() > 2 * MaxValue<idx_t>(out.size(), GZIP_MIN_OUTPUT_CHUNK)) {
+		out.shrink_to_fit();
+	}
+	return ret;
+}
 
-		if (ret != Z_OK && ret != Z_STREAM_END) {
-			inflateEnd(&stream);
-			return "[Error: Gzip decompression failed with code " + to_string(ret) + "]";
-		}
-
-		size_t produced = chunk_size - stream.avail_out;
-		decompressed_buffer.insert(decompressed_buffer.end(), out_buffer, out_buffer + produced);
-
-	} while (ret != Z_STREAM_END);
-
-	inflateEnd(&stream);
+string DecompressGzip(const char *compressed_data, size_t compressed_size) {
+	auto stream = GetThreadInflater().Begin(compressed_data, compressed_size);
+	if (!stream) {
+		return "[Error: Failed to initialize gzip decompression]";
+	}
+	// The whole member is here, so the trailer tells us how much to allocate up front (within a ceiling)
+	string out;
+	auto ret = InflateInto(*stream, out, GzipInflatedSizeHint(compressed_data, compressed_size),
+	                       GZIP_MAX_OUTPUT_STEP, nullptr);
+	if (ret != Z_STREAM_END) {
+		return "[Error: Gzip decompression failed with code " + to_string(ret) + "]";
+	}
+	return out;
+}
 
-	// Convert to string
-	return string(decompressed_buffer.begin(), decompressed_buffer.end());
+GzipPrefixResult DecompressGzipPrefix(const char *compressed_data, size_t compressed_size,
+                                      const std::function<bool(const string &out)> &stop, string &out) {
+	auto stream = GetThreadInflater().Begin(compressed_data, compressed_size);
+	if (!stream) {
+		out = "[Error: Failed to initialize gzip decompression]";
+		return GzipPrefixResult::COMPLETE;
+	}
+	// Inflate in chunk-sized steps so stop() runs as soon as enough output exists
+	auto ret = InflateInto(*stream, out, GZIP_MIN_OUTPUT_CHUNK, GZIP_MIN_OUTPUT_CHUNK, &stop);
+	if (ret == Z_OK) {
+		return GzipPrefixResult::STOPPED;
+	}
+	if (ret == Z_BUF_ERROR && stream->avail_in == 0) {
+		// No progress possible: the input stops mid-stream
+		return stop(out) ? GzipPrefixResult::STOPPED : GzipPrefixResult::INPUT_EXHAUSTED;
+	}
+	if (ret != Z_STREAM_END) {
+		out = "[Error: Gzip decompression failed with code " + to_string(ret) + "]";
+	}
+	return GzipPrefixResult::COMPLETE;
 }
 
 // ========================================
 // HTTP/WARC PARSING
 // ========================================
 
-unordered_map<string, string> ParseHeaders(const string &header_text) {
-	unordered_map<string, string> headers;
+// Find the blank line that ends a header block starting at pos: CRLF CRLF, or LF LF for sloppy writers.
+// Sets block_end to the start of the blank line and returns the offset just past it (string::npos if absent).
+static idx_t FindHeaderBlockEnd(const string &data, idx_t pos, idx_t &block_end) {
+	auto crlf = data.find("\r\n\r\n", pos);
+	if (crlf != string::npos) {
+		block_end = crlf;
+		return crlf + 4;
+	}
+	auto lf = data.find("\n\n", pos);
+	if (lf != string::npos) {
+		block_end = lf;
+		return lf + 2;
+	}
+	return string::npos;
+}
+
+// End of the line starting at pos (without its CR), bounded by end; next is set to the start of the next line
+static idx_t FindLineEnd(const string &data, idx_t pos, idx_t end, idx_t &next) {
+	auto newline = static_cast<const char *>(memchr(data.data() + pos, '\n', end - pos));
+	idx_t line_end = newline ? NumericCast<idx_t>(newline - data.data()) : end;
+	next = line_end + 1;
+	if (line_end > pos && data[line_end - 1] == '\r') {
+		line_end--;
+	}
+	return line_end;
+}
 
-	size_t pos = 0;
-	size_t line_end;
-
-	while (pos < header_text.length()) {
-		// Find end of line
-		line_end = header_text.find("\r\n", pos);
-		if (line_end == string::npos) {
-			line_end = header_text.find("\n", pos);
-			if (line_end == string::npos) {
+void ParseHeaderSpans(const string &data, idx_t begin, idx_t end, vector<WARCHeaderSpan> &headers) {
+	idx_t pos = begin;
+	while (pos < end) {
+		idx_t next;
+		idx_t line_end = FindLineEnd(data, pos, end, next);
+		// "Name: value" - the separator is the first ": " of the line
+		for (idx_t i = pos; i + 1 < line_end; i++) {
+			if (data[i] == ':' && data[i + 1] == ' ') {
+				WARCHeaderSpan header;
+				header.name.offset = pos;
+				header.name.length = i - pos;
+				header.value.offset = i + 2;
+				header.value.length = line_end - (i + 2);
+				headers.push_back(header);
 				break;
 			}
 		}
+		pos = next;
+	}
+}
 
-		string line = header_text.substr(pos, line_end - pos);
+void ParseWARCResponse(WARCResponse &response, bool parse_warc_headers, bool parse_http_headers) {
+	// WARC format structure:
+	// 1. WARC version line + headers (metadata about the record)
+	// 2. HTTP status line + headers
+	// 3. HTTP body (actual content)
+	auto &data = *response.data;
 
-		// Find colon separator
-		size_t colon_pos = line.find(": ");
-		if (colon_pos != string::npos) {
-			string key = line.substr(0, colon_pos);
-			string value = line.substr(colon_pos + 2);
+	idx_t warc_headers_end;
+	idx_t http_start = FindHeaderBlockEnd(data, 0, warc_headers_end);
+	if (http_start == string::npos) {
+		return; // Invalid WARC format
+	}
 
-			// If key already exists, concatenate with ", "
-			auto it = headers.find(key);
-			if (it != headers.end()) {
-				it->second += ", " + value;
-			} else {
-				headers[key] = value;
+	// Version line (e.g., "WARC/1.0"), then the WARC headers
+	idx_t warc_headers_start;
+	idx_t version_end = FindLineEnd(data, 0, warc_headers_end, warc_headers_start);
+	if (data.compare(0, 5, "WARC/") == 0 && version_end >= 5) {
+		response.warc_version.offset = 5;
+		response.warc_version.length = version_end - 5;
+	}
+	if (parse_warc_headers) {
+		ParseHeaderSpans(data, warc_headers_start, warc_headers_end, response.warc_headers);
+	}
+
+	// After WARC headers comes the HTTP response
+	idx_t http_headers_end;
+	idx_t body_start = FindHeaderBlockEnd(data, http_start, http_headers_end);
+	if (body_start == string::npos) {
+		return; // Invalid HTTP format
+	}
+
+	// Status line (e.g., "HTTP/1.1 200 OK"), then the HTTP headers
+	idx_t http_headers_start;
+	idx_t status_end = FindLineEnd(data, http_start, http_headers_end, http_headers_start);
+	if (data.compare(http_start, 5, "HTTP/") == 0) {
+		auto space1 = data.find(' ', http_start);
+		if (space1 != string::npos && space1 < status_end) {
+			response.http_version.offset = http_start + 5;
+			response.http_version.length = space1 - (http_start + 5);
+			int status = 0;
+			idx_t digits = 0;
+			for (idx_t i = space1 + 1; i < status_end && data[i] >= '0' && data[i] <= '9' && digits < 9; i++) {
+				status = status * 10 + (data[i] - '0');
+				digits++;
+			}
+			response.http_status_code = status;
+		}
+	}
+	if (parse_http_headers) {
+		ParseHeaderSpans(data, http_headers_start, http_headers_end, response.http_headers);
+	}
+
+	response.body.offset = body_start;
+	response.body.length = data.size() - body_start;
+}
+
+idx_t FindWARCPayloadStart(const string &warc_data) {
+	idx_t block_end;
+	auto http_start = FindHeaderBlockEnd(warc_data, 0, block_end);
+	if (http_start == string::npos) {
+		return string::npos;
+	}
+	return FindHeaderBlockEnd(warc_data, http_start, block_end);
+}
+
+// ========================================
+// STRUCT PROJECTION
+// ========================================
+
+vector<bool> ProjectedStructFields(const ColumnIndex &column, idx_t field_count) {
+	if (!column.HasChildren()) {
+		return vector<bool>(field_count, true);
+	}
+	vector<bool> used(field_count, false);
+	for (auto &child : column.GetChildIndexes()) {
+		if (child.GetPrimaryIndex() < field_count) {
+			used[child.GetPrimaryIndex()] = true;
+		}
+	}
+	return used;
+}
+
+void WriteHeaderMap(Vector &map_vector, idx_t row, const WARCResponse &response,
+                    const vector<WARCHeaderSpan> &headers) {
+	auto &map_keys = MapVector::GetKeys(map_vector);
+	auto &map_values = MapVector::GetValues(map_vector);
+
+	idx_t map_offset = ListVector::GetListSize(map_vector);
+	ListVector::Reserve(map_vector, map_offset + headers.size());
+
+	auto key_data = FlatVector::GetData<string_t>(map_keys);
+	auto value_data = FlatVector::GetData<string_t>(map_values);
+	auto map_data = FlatVector::GetData<list_entry_t>(map_vector);
+	map_data[row].offset = map_offset;
+
+	auto same_name = [&response](const WARCHeaderSpan &a, const WARCHeaderSpan &b) {
+		return a.name.length == b.name.length &&
+		       memcmp(response.Ptr(a.name), response.Ptr(b.name), a.name.length) == 0;
+	};
+	for (idx_t i = 0; i < headers.size(); i++) {
+		auto &header = headers[i];
+		// MAP keys must be unique: a repeated name was already written with its first occurrence
+		bool seen = false;
+		for (idx_t j = 0; j < i && !seen; j++) {
+			seen = same_name(headers[j], header);
+		}
+		if (seen) {
+			continue;
+		}
+		key_data[map_offset] = AddSanitizedString(map_keys, response.Ptr(header.name), header.name.length);
+
+		// Values of a repeated header are joined with ", "
+		string joined;
+		bool repeated = false;
+		for (idx_t j = i + 1; j < headers.size(); j++) {
+			if (!same_name(headers[j], header)) {
+				continue;
+			}
+			if (!repeated) {
+				joined.assign(response.Ptr(header.value), header.value.length);
+				repeated = true;
 			}
+			joined += ", ";
+			joined.append(response.Ptr(headers[j].value), headers[j].value.length);
 		}
+		if (repeated) {
+			value_data[map_offset] = AddSanitizedString(map_values, joined.data(), joined.size());
+		} else {
+			value_data[map_offset] = AddSanitizedString(map_values, response.Ptr(header.value), header.value.length);
+		}
+		map_offset++;
+	}
+	map_data[row].length = map_offset - map_data[row].offset;
+	ListVector::SetListSize(map_vector, map_offset);
+}
+
+string_t AddSanitizedString(Vector &vector, const char *data, idx_t length) {
+	if (IsValidUTF8(data, length)) {
+		return StringVector::AddString(vector, data, length);
+	}
+	return StringVector::AddString(vector, RepairUTF8(data, length));
+}
+
+string_t AddSanitizedString(Vector &vector, const string &str) {
+	return AddSanitizedString(vector, str.data(), str.size());
+}
+
+// Keeps a shared string alive for as long as a vector references its bytes
+class WARCRecordBuffer : public VectorBuffer {
+public:
+	explicit WARCRecordBuffer(shared_ptr<string> data_p)
+	    : VectorBuffer(VectorBufferType::OPAQUE_BUFFER), data(std::move(data_p)) {
+	}
+
+private:
+	shared_ptr<string> data;
+};
+
+string_t AddSharedBlob(Vector &vector, const shared_ptr<string> &buffer, const char *data, idx_t length) {
+	if (length <= string_t::INLINE_LENGTH) {
+		// Short strings are stored inline in the string_t itself
+		return string_t(data, UnsafeNumericCast<uint32_t>(length));
+	}
+	StringVector::AddBuffer(vector, make_buffer<WARCRecordBuffer>(buffer));
+	return string_t(data, NumericCast<uint32_t>(length));
+}
 
-		// Move to next line
+void SetUnusedStructField(Vector &child, idx_t row) {
+	if (child.GetType().InternalType() == PhysicalType::LIST) {
+		auto list_data = FlatVector::GetData<list_entry_t>(child);
+		list_data[row].offset = ListVector::GetListSize(child);
+		list_data[row].length = 0;
+	}
+	FlatVector::SetNull(child, row, true);
+}
+
+// ========================================
+// CDX STREAMING PARSE
+// ========================================
+
+// Read size for streamed CDX responses; large reads keep the per-call overhead of httpfs low
+static constexpr idx_t CDX_STREAM_BUFFER_SIZE = 256 * 1024;
+
+CDXLineReader::CDXLineReader(std::function<bool(const char *line, idx_t length)> on_line_p)
+    : on_line(std::move(on_line_p)), stopped(false) {
+}
+
+bool CDXLineReader::Emit(const char *line, idx_t length) {
+	if (length > 0 && line[length - 1] == '\r') {
+		length--;
+	}
+	stopped = !on_line(line, length);
+	return !stopped;
+}
+
+bool CDXLineReader::Feed(const char *data, idx_t size) {
+	idx_t pos = 0;
+	while (!stopped && pos < size) {
+		auto newline = static_cast<const char *>(memchr(data + pos, '\n', size - pos));
+		if (!newline) {
+			carry.append(data + pos, size - pos);
+			break;
+		}
+		idx_t line_end = newline - data;
+		if (carry.empty()) {
+			// Common case: the whole line is inside the chunk
+			Emit(data + pos, line_end - pos);
+		} else {
+			carry.append(data + pos, line_end - pos);
+			Emit(carry.data(), carry.size());
+			carry.clear();
+		}
 		pos = line_end + 1;
-		if (pos < header_text.length() && header_text[pos] == '\n') {
-			pos++;
+	}
+	return !stopped;
+}
+
+void CDXLineReader::Finish() {
+	if (!stopped && !carry.empty()) {
+		Emit(carry.data(), carry.size());
+		carry.clear();
+	}
+}
+
+void StreamCDXResponse(ClientContext &context, const string &url,
+                       const std::function<bool(const char *line, idx_t length)> &on_line) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	auto file_handle = fs.OpenFile(url, FileFlags::FILE_FLAGS_READ);
+
+	auto buffer = unique_ptr<char[]>(new char[CDX_STREAM_BUFFER_SIZE]);
+	CDXLineReader reader(on_line);
+	while (true) {
+		int64_t bytes_read = file_handle->Read(buffer.get(), CDX_STREAM_BUFFER_SIZE);
+		if (bytes_read <= 0) {
+			break;
+		}
+		if (!reader.Feed(buffer.get(), NumericCast<idx_t>(bytes_read))) {
+			return;
 		}
 	}
+	reader.Finish();
+}
 
-	return headers;
+void AssignSanitized(string &out, const char *data, idx_t length) {
+	if (IsValidUTF8(data, length)) {
+		out.assign(data, length);
+		return;
+	}
+	out = RepairUTF8(data, length);
 }
 
-WARCResponse ParseWARCResponse(const string &warc_data) {
-	WARCResponse result;
+// Digits that always fit in an int64_t
+static constexpr idx_t CDX_INTEGER_MAX_DIGITS = 18;
 
-	// WARC format structure:
-	// 1. WARC version line + headers (metadata about the record)
-	// 2. HTTP status line + headers
-	// 3. HTTP body (actual content)
+int64_t ParseCDXInteger(const char *data, idx_t length) {
+	int64_t result = 0;
+	for (idx_t i = 0; i < length; i++) {
+		if (data[i] < '0' || data[i] > '9') {
+			return i == 0 ? 0 : result;
+		}
+		if (i == CDX_INTEGER_MAX_DIGITS) {
+			return NumericLimits<int64_t>::Maximum();
+		}
+		result = result * 10 + (data[i] - '0');
+	}
+	return result;
+}
+
+// Compare a JSON key (not NUL-terminated) with a literal
+template <idx_t N>
+static inline bool JSONKeyIs(const char *key, idx_t key_length, const char (&literal)[N]) {
+	return key_length == N - 1 && memcmp(key, literal, N - 1) == 0;
+}
+
+// Parse one NDJSON CDX line straight into a record in a single pass; false for lines without a url
+bool ParseCDXJsonLine(const char *line, idx_t length, const string &index_name, bool need_warc_fields,
+                      CDXRecord &record) {
+	ScanJSONFields(line, length, [&](const char *key, idx_t key_length, const char *value, idx_t value_length) {
+		if (JSONKeyIs(key, key_length, "url")) {
+			AssignSanitized(record.url, value, value_length);
+		} else if (JSONKeyIs(key, key_length, "timestamp")) {
+			AssignSanitized(record.timestamp, value, value_length);
+		} else if (JSONKeyIs(key, key_length, "mime")) {
+			AssignSanitized(record.mime_type, value, value_length);
+		} else if (JSONKeyIs(key, key_length, "digest")) {
+			AssignSanitized(record.digest, value, value_length);
+		} else if (JSONKeyIs(key, key_length, "status")) {
+			record.status_code = NumericCast<int32_t>(ParseCDXInteger(value, value_length));
+		} else if (need_warc_fields) {
+			if (JSONKeyIs(key, key_length, "filename")) {
+				AssignSanitized(record.filename, value, value_length);
+			} else if (JSONKeyIs(key, key_length, "offset")) {
+				record.offset = ParseCDXInteger(value, value_length);
+			} else if (JSONKeyIs(key, key_length, "length")) {
+				record.length = ParseCDXInteger(value, value_length);
+			}
+		}
+	});
+	if (record.url.empty()) {
+		return false; // Skip invalid records
+	}
+	record.crawl_id = index_name;
+	return true;
+}
+
+// ========================================
+// COLUMNAR RECORD BATCHES
+// ========================================
 
-	// Find the end of WARC headers (double newline)
-	size_t warc_headers_end = warc_data.find("\r\n\r\n");
-	size_t newline_size = 4;
-	if (warc_headers_end == string::npos) {
-		warc_headers_end = warc_data.find("\n\n");
-		newline_size = 2;
-		if (warc_headers_end == string::npos) {
-			return result; // Invalid WARC format
+void CDXStringColumn::AppendRows(const CDXStringColumn &other, idx_t begin, idx_t count) {
+	if (count == 0) {
+		return;
+	}
+	auto byte_begin = other.Start(begin);
+	auto byte_end = other.ends[begin + count - 1];
+	auto shift = bytes.size() - byte_begin;
+	bytes.append(other.bytes, byte_begin, byte_end - byte_begin);
+	for (idx_t row = begin; row < begin + count; row++) {
+		ends.push_back(other.ends[row] + shift);
+	}
+}
+
+template <class T>
+static void AppendFixedRows(vector<T> &target, const vector<T> &source, idx_t begin, idx_t count) {
+	target.insert(target.end(), source.begin() + begin, source.begin() + begin + count);
+}
+
+void CDXRecordBatch::Append(const CDXRecord &record) {
+	Append(record, ParseCDXTimestamp(record.timestamp));
+}
+
+void CDXRecordBatch::Append(const CDXRecord &record, timestamp_t record_timestamp) {
+	url.Append(record.url);
+	filename.Append(record.filename);
+	mime_type.Append(record.mime_type);
+	digest.Append(record.digest);
+	timestamp.push_back(record_timestamp);
+	status_code.push_back(record.status_code);
+	offset.push_back(record.offset);
+	length.push_back(record.length);
+}
+
+void CDXRecordBatch::AppendRows(const CDXRecordBatch &other, idx_t begin, idx_t count) {
+	url.AppendRows(other.url, begin, count);
+	filename.AppendRows(other.filename, begin, count);
+	mime_type.AppendRows(other.mime_type, begin, count);
+	digest.AppendRows(other.digest, begin, count);
+	AppendFixedRows(timestamp, other.timestamp, begin, count);
+	AppendFixedRows(status_code, other.status_code, begin, count);
+	AppendFixedRows(offset, other.offset, begin, count);
+	AppendFixedRows(length, other.length, begin, count);
+}
+
+void ArchiveOrgRecordBatch::Append(const ArchiveOrgRecord &record) {
+	urlkey.Append(record.urlkey);
+	timestamp.Append(record.timestamp);
+	original.Append(record.original);
+	mime_type.Append(record.mime_type);
+	status_code.push_back(record.status_code);
+	digest.Append(record.digest);
+	length.push_back(record.length);
+}
+
+void ArchiveOrgRecordBatch::AppendRows(const ArchiveOrgRecordBatch &other, idx_t begin, idx_t count) {
+	urlkey.AppendRows(other.urlkey, begin, count);
+	timestamp.AppendRows(other.timestamp, begin, count);
+	original.AppendRows(other.original, begin, count);
+	mime_type.AppendRows(other.mime_type, begin, count);
+	AppendFixedRows(status_code, other.status_code, begin, count);
+	digest.AppendRows(other.digest, begin, count);
+	AppendFixedRows(length, other.length, begin, count);
+	if (other.input_url.Size() > 0) {
+		input_url.AppendRows(other.input_url, begin, count);
+	}
+	if (other.lookup_error.Size() > 0) {
+		lookup_error.AppendRows(other.lookup_error, begin, count);
+	}
+}
+
+ArchiveOrgRecord ArchiveOrgRecordBatch::Get(idx_t row) const {
+	ArchiveOrgRecord record;
+	record.urlkey = urlkey.Get(row);
+	record.timestamp = timestamp.Get(row);
+	record.original = original.Get(row);
+	record.mime_type = mime_type.Get(row);
+	record.status_code = status_code[row];
+	record.digest = digest.Get(row);
+	record.length = length[row];
+	return record;
+}
+
+// ========================================
+// CDX RESULT CACHE
+// ========================================
+
+string NormalizeCDXUrl(const string &cdx_url) {
+	auto query_start = cdx_url.find('?');
+	if (query_start == string::npos) {
+		return cdx_url;
+	}
+	vector<string> params;
+	idx_t pos = query_start + 1;
+	while (pos <= cdx_url.size()) {
+		auto amp = cdx_url.find('&', pos);
+		if (amp == string::npos) {
+			amp = cdx_url.size();
+		}
+		if (amp > pos) {
+			params.push_back(cdx_url.substr(pos, amp - pos));
 		}
+		pos = amp + 1;
 	}
+	auto param_name = [](const string &param) {
+		return param.substr(0, param.find('='));
+	};
+	std::stable_sort(params.begin(), params.end(), [&param_name](const string &a, const string &b) {
+		return param_name(a) < param_name(b);
+	});
+
+	string normalized = cdx_url.substr(0, query_start + 1);
+	for (idx_t i = 0; i < params.size(); i++) {
+		if (i > 0) {
+			normalized += "&";
+		}
+		normalized += params[i];
+	}
+	return normalized;
+}
+
+// Bumped whenever the layout below changes; older cache entries then read as misses
+static constexpr uint32_t CDX_CACHE_FORMAT_VERSION = 2;
+
+template <class T>
+static void AppendFixed(string &out, T value) {
+	out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+// Columns are stored as laid out in memory: a string column is its end offsets followed by its bytes
+static void AppendStringColumn(string &out, const CDXStringColumn &column) {
+	out.append(reinterpret_cast<const char *>(column.ends.data()), column.ends.size() * sizeof(idx_t));
+	out += column.bytes;
+}
 
-	// Extract WARC section
-	string warc_section = warc_data.substr(0, warc_headers_end);
+template <class T>
+static void AppendFixedColumn(string &out, const vector<T> &column) {
+	out.append(reinterpret_cast<const char *>(column.data()), column.size() * sizeof(T));
+}
+
+// Bounds-checked reader over a serialized result
+struct ColumnReader {
+	const string &data;
+	idx_t pos;
+	idx_t count;
 
-	// Parse WARC version from first line (e.g., "WARC/1.0")
-	size_t first_line_end = warc_section.find("\r\n");
-	if (first_line_end == string::npos) {
-		first_line_end = warc_section.find("\n");
+	explicit ColumnReader(const string &data_p) : data(data_p), pos(0), count(0) {
 	}
 
-	if (first_line_end != string::npos) {
-		string version_line = warc_section.substr(0, first_line_end);
-		if (version_line.find("WARC/") == 0) {
-			result.warc_version = version_line.substr(5); // Extract version after "WARC/"
+	template <class T>
+	bool ReadFixed(T &value) {
+		if (pos + sizeof(T) > data.size()) {
+			return false;
 		}
+		memcpy(&value, data.data() + pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
 
-		// Parse remaining WARC headers (skip version line)
-		size_t warc_headers_start = first_line_end + 1;
-		if (warc_headers_start < warc_section.length() && warc_section[warc_headers_start] == '\n') {
-			warc_headers_start++;
+	bool ReadString(string &value) {
+		uint32_t length;
+		if (!ReadFixed<uint32_t>(length) || pos + length > data.size()) {
+			return false;
 		}
-		string warc_headers_text = warc_section.substr(warc_headers_start);
-		result.warc_headers = ParseHeaders(warc_headers_text);
+		value.assign(data.data() + pos, length);
+		pos += length;
+		return true;
 	}
 
-	// After WARC headers comes the HTTP response
-	size_t http_start = warc_headers_end + newline_size;
-	size_t http_headers_end = warc_data.find("\r\n\r\n", http_start);
-	size_t http_newline_size = 4;
-	if (http_headers_end == string::npos) {
-		http_headers_end = warc_data.find("\n\n", http_start);
-		http_newline_size = 2;
-		if (http_headers_end == string::npos) {
-			return result; // Invalid HTTP format
-		}
-	}
-
-	// Extract HTTP section
-	string http_section = warc_data.substr(http_start, http_headers_end - http_start);
-
-	// Parse HTTP status line (e.g., "HTTP/1.1 200")
-	size_t http_first_line_end = http_section.find("\r\n");
-	if (http_first_line_end == string::npos) {
-		http_first_line_end = http_section.find("\n");
-	}
-
-	if (http_first_line_end != string::npos) {
-		string status_line = http_section.substr(0, http_first_line_end);
-
-		// Parse "HTTP/1.1 200 OK" format
-		size_t space1 = status_line.find(" ");
-		if (space1 != string::npos && status_line.find("HTTP/") == 0) {
-			// Extract version (e.g., "1.1" from "HTTP/1.1")
-			result.http_version = status_line.substr(5, space1 - 5);
-
-			// Extract status code
-			size_t space2 = status_line.find(" ", space1 + 1);
-			string status_str;
-			if (space2 != string::npos) {
-				status_str = status_line.substr(space1 + 1, space2 - space1 - 1);
-			} else {
-				status_str = status_line.substr(space1 + 1);
-			}
+	template <class T>
+	bool ReadFixedColumn(vector<T> &column) {
+		if (count > (data.size() - pos) / sizeof(T)) {
+			return false;
+		}
+		column.resize(count);
+		if (count > 0) {
+			memcpy(column.data(), data.data() + pos, count * sizeof(T));
+		}
+		pos += count * sizeof(T);
+		return true;
+	}
 
-			try {
-				result.http_status_code = std::stoi(status_str);
-			} catch (...) {
-				result.http_status_code = 0;
+	bool ReadStringColumn(CDXStringColumn &column) {
+		if (!ReadFixedColumn(column.ends)) {
+			return false;
+		}
+		idx_t previous_end = 0;
+		for (auto end : column.ends) {
+			if (end < previous_end) {
+				return false;
 			}
+			previous_end = end;
+		}
+		if (previous_end > data.size() - pos) {
+			return false;
 		}
+		column.bytes.assign(data.data() + pos, previous_end);
+		pos += previous_end;
+		return true;
+	}
 
-		// Parse HTTP headers (skip status line)
-		size_t http_headers_start = http_first_line_end + 1;
-		if (http_headers_start < http_section.length() && http_section[http_headers_start] == '\n') {
-			http_headers_start++;
+	// Read the version/count header
+	bool ReadHeader() {
+		uint32_t version;
+		uint64_t row_count;
+		if (!ReadFixed<uint32_t>(version) || version != CDX_CACHE_FORMAT_VERSION || !ReadFixed<uint64_t>(row_count)) {
+			return false;
+		}
+		// Every record takes at least a few bytes - reject counts the data cannot possibly hold
+		if (row_count > data.size()) {
+			return false;
 		}
-		string http_headers_text = http_section.substr(http_headers_start);
-		result.http_headers = ParseHeaders(http_headers_text);
+		count = row_count;
+		return true;
 	}
+};
+
+string SerializeCDXRecords(const CDXRecordBatch &records) {
+	string out;
+	AppendFixed<uint32_t>(out, CDX_CACHE_FORMAT_VERSION);
+	AppendFixed<uint64_t>(out, records.Size());
+	AppendFixed<uint32_t>(out, NumericCast<uint32_t>(records.crawl_id.size()));
+	out += records.crawl_id;
+	AppendStringColumn(out, records.url);
+	AppendStringColumn(out, records.filename);
+	AppendStringColumn(out, records.mime_type);
+	AppendStringColumn(out, records.digest);
+	AppendFixedColumn(out, records.timestamp);
+	AppendFixedColumn(out, records.status_code);
+	AppendFixedColumn(out, records.offset);
+	AppendFixedColumn(out, records.length);
+	return out;
+}
 
-	// Extract HTTP body
-	result.body = warc_data.substr(http_headers_end + http_newline_size);
+bool DeserializeCDXRecords(const string &data, CDXRecordBatch &records) {
+	ColumnReader reader(data);
+	return reader.ReadHeader() && reader.ReadString(records.crawl_id) && reader.ReadStringColumn(records.url) &&
+	       reader.ReadStringColumn(records.filename) && reader.ReadStringColumn(records.mime_type) &&
+	       reader.ReadStringColumn(records.digest) && reader.ReadFixedColumn(records.timestamp) &&
+	       reader.ReadFixedColumn(records.status_code) && reader.ReadFixedColumn(records.offset) &&
+	       reader.ReadFixedColumn(records.length) && reader.pos == data.size();
+}
 
-	return result;
+string SerializeArchiveOrgRecords(const ArchiveOrgRecordBatch &records) {
+	string out;
+	AppendFixed<uint32_t>(out, CDX_CACHE_FORMAT_VERSION);
+	AppendFixed<uint64_t>(out, records.Size());
+	AppendStringColumn(out, records.urlkey);
+	AppendStringColumn(out, records.timestamp);
+	AppendStringColumn(out, records.original);
+	AppendStringColumn(out, records.mime_type);
+	AppendFixedColumn(out, records.status_code);
+	AppendStringColumn(out, records.digest);
+	AppendFixedColumn(out, records.length);
+	return out;
+}
+
+bool DeserializeArchiveOrgRecords(const string &data, ArchiveOrgRecordBatch &records) {
+	ColumnReader reader(data);
+	return reader.ReadHeader() && reader.ReadStringColumn(records.urlkey) &&
+	       reader.ReadStringColumn(records.timestamp) && reader.ReadStringColumn(records.original) &&
+	       reader.ReadStringColumn(records.mime_type) && reader.ReadFixedColumn(records.status_code) &&
+	       reader.ReadStringColumn(records.digest) && reader.ReadFixedColumn(records.length) &&
+	       reader.pos == data.size();
 }
 
 // ========================================
@@ -462,18 +1001,38 @@ static string ExtractJSONStringField(const string &json, const string &field) {
 	return json.substr(start, end - start);
 }
 
-// Fetch and cache all crawl infos from collinfo.json
-static void FetchCollInfo(ClientContext &context) {
-	DUCKDB_LOG_DEBUG(context, "Fetching collinfo.json +%.0fms", ElapsedMs());
+static constexpr const char *COLLINFO_URL = "https://index.commoncrawl.org/collinfo.json";
+// collinfo.json only changes when a crawl is published, so a copy is used for a day
+static constexpr int64_t COLLINFO_TTL_SECONDS = 24 * 60 * 60;
+// Age from which a query refreshes the copy in the background while still using it
+static constexpr int64_t COLLINFO_REFRESH_SECONDS = 20 * 60 * 60;
+
+// Process-wide collinfo.json cache. At most one download runs at a time; callers without a usable copy wait
+// for it instead of starting their own.
+struct CollInfoCache {
+	std::mutex lock;
+	std::condition_variable fetched;
+	shared_ptr<const CollInfo> current;
+	bool fetching = false;
+};
+
+static CollInfoCache &GetCollInfoCache() {
+	static CollInfoCache cache;
+	return cache;
+}
 
-	string collinfo_url = "https://index.commoncrawl.org/collinfo.json";
+static int64_t CollInfoAgeSeconds(const CollInfo &collinfo) {
+	return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - collinfo.fetched_at)
+	    .count();
+}
 
+static void EnableForceDownload(ClientContext &context) {
 	// Set force_download globally to skip HEAD request for this fetch
 	context.db->GetDatabase(context).config.SetOption("force_download", Value(true));
+}
 
-	// Use FileSystem to fetch directly
-	auto &fs = FileSystem::GetFileSystem(context);
-	auto file_handle = fs.OpenFile(collinfo_url, FileFlags::FILE_FLAGS_READ);
+static string DownloadCollInfo(FileSystem &fs) {
+	auto file_handle = fs.OpenFile(COLLINFO_URL, FileFlags::FILE_FLAGS_READ);
 
 	// Read entire response
 	string response_data;
@@ -490,10 +1049,13 @@ static void FetchCollInfo(ClientContext &context) {
 	if (response_data.empty()) {
 		throw IOException("Failed to fetch collinfo.json: empty response");
 	}
+	return response_data;
+}
 
-	// Clear and populate cache
-	g_collinfo_cache.crawl_infos.clear();
-	g_collinfo_cache.latest_crawl_id = "";
+static shared_ptr<const CollInfo> ParseCollInfo(const string &response_data,
+                                                std::chrono::system_clock::time_point fetched_at) {
+	auto collinfo = make_shared_ptr<CollInfo>();
+	collinfo->fetched_at = fetched_at;
 
 	// Parse JSON array manually - each entry is an object with id, name, from, to
 	// Format: [{"id": "CC-MAIN-2025-47", "name": "November 2025 Index", "from": "2025-11-06T20:07:18", "to":
@@ -523,47 +1085,159 @@ static void FetchCollInfo(ClientContext &context) {
 		if (!info.id.empty()) {
 			info.from_ts = ParseISO8601Timestamp(from_str);
 			info.to_ts = ParseISO8601Timestamp(to_str);
-			g_collinfo_cache.crawl_infos.push_back(info);
 
 			// First entry is the latest
-			if (g_collinfo_cache.latest_crawl_id.empty()) {
-				g_collinfo_cache.latest_crawl_id = info.id;
+			if (collinfo->latest_crawl_id.empty()) {
+				collinfo->latest_crawl_id = info.id;
 			}
+			collinfo->crawl_infos.push_back(std::move(info));
 		}
 
 		pos = obj_end + 1;
 	}
 
-	if (g_collinfo_cache.crawl_infos.empty()) {
+	if (collinfo->crawl_infos.empty()) {
 		throw IOException("collinfo.json parsing failed: no valid entries found");
 	}
 
-	g_collinfo_cache.cached_at = std::chrono::system_clock::now();
-	g_collinfo_cache.is_valid = true;
+	// Sorted by start so timestamp ranges resolve with binary searches
+	auto &crawls = collinfo->crawl_infos;
+	std::stable_sort(crawls.begin(), crawls.end(),
+	                 [](const CrawlInfo &a, const CrawlInfo &b) { return a.from_ts < b.from_ts; });
+	for (auto &info : crawls) {
+		auto to_ts = collinfo->max_to_ts.empty() ? info.to_ts : MaxValue(collinfo->max_to_ts.back(), info.to_ts);
+		collinfo->max_to_ts.push_back(to_ts);
+	}
+	return std::move(collinfo);
+}
+
+// Persisted copy: the fetch time (seconds since the epoch) on the first line, then collinfo.json as downloaded
+static constexpr const char *COLLINFO_CACHE_KEY = "collinfo.json";
 
-	DUCKDB_LOG_DEBUG(context, "Cached %lu crawl infos, latest: %s +%.0fms",
-	                 (unsigned long)g_collinfo_cache.crawl_infos.size(), g_collinfo_cache.latest_crawl_id.c_str(),
-	                 ElapsedMs());
+static void PersistCollInfo(DiskCache &disk_cache, const string &response_data,
+                            std::chrono::system_clock::time_point fetched_at) {
+	auto seconds = std::chrono::duration_cast<std::chrono::seconds>(fetched_at.time_since_epoch()).count();
+	auto entry = to_string(seconds) + "\n" + response_data;
+	disk_cache.Write(COLLINFO_CACHE_KEY, entry.data(), entry.size());
 }
 
-string GetLatestCrawlId(ClientContext &context) {
-	// Check if cache is valid and not expired
-	if (g_collinfo_cache.IsExpired()) {
-		FetchCollInfo(context);
+static shared_ptr<const CollInfo> LoadPersistedCollInfo(DiskCache &disk_cache) {
+	string entry;
+	if (!disk_cache.Read(COLLINFO_CACHE_KEY, entry, COLLINFO_TTL_SECONDS)) {
+		return nullptr;
+	}
+	auto newline = entry.find('\n');
+	if (newline == string::npos) {
+		return nullptr;
+	}
+	try {
+		auto seconds = std::stoll(entry.substr(0, newline));
+		std::chrono::system_clock::time_point fetched_at {std::chrono::seconds(seconds)};
+		auto collinfo = ParseCollInfo(entry.substr(newline + 1), fetched_at);
+		if (CollInfoAgeSeconds(*collinfo) >= COLLINFO_TTL_SECONDS) {
+			return nullptr;
+		}
+		return collinfo;
+	} catch (std::exception &) {
+		return nullptr; // Unreadable entries are fetched again
+	}
+}
+
+static shared_ptr<const CollInfo> FetchCollInfo(FileSystem &fs, const shared_ptr<DiskCache> &disk_cache) {
+	auto response_data = DownloadCollInfo(fs);
+	auto fetched_at = std::chrono::system_clock::now();
+	auto collinfo = ParseCollInfo(response_data, fetched_at);
+	if (disk_cache) {
+		PersistCollInfo(*disk_cache, response_data, fetched_at);
 	}
-	return g_collinfo_cache.latest_crawl_id;
+	return collinfo;
 }
 
-const vector<CrawlInfo> &GetCrawlInfos(ClientContext &context) {
-	// Check if cache is valid and not expired
-	if (g_collinfo_cache.IsExpired()) {
-		FetchCollInfo(context);
+// End a download: publish its result (nullptr when it failed) and wake the callers waiting for it
+static void FinishCollInfoFetch(CollInfoCache &cache, shared_ptr<const CollInfo> collinfo) {
+	{
+		std::lock_guard<std::mutex> guard(cache.lock);
+		if (collinfo) {
+			cache.current = std::move(collinfo);
+		}
+		cache.fetching = false;
 	}
-	return g_collinfo_cache.crawl_infos;
+	cache.fetched.notify_all();
+}
+
+// Replace an aging copy without making the query wait; a failed refresh keeps the old copy until it expires
+static void RefreshCollInfoInBackground(ClientContext &context, shared_ptr<DiskCache> disk_cache) {
+	auto &cache = GetCollInfoCache();
+	auto db = context.db;
+	EnableForceDownload(context);
+	try {
+		FetchExecutor::Get().Submit(GetUrlHost(COLLINFO_URL), [&cache, db, disk_cache]() {
+			shared_ptr<const CollInfo> collinfo;
+			try {
+				collinfo = FetchCollInfo(FileSystem::GetFileSystem(*db), disk_cache);
+			} catch (std::exception &) {
+			}
+			FinishCollInfoFetch(cache, std::move(collinfo));
+		});
+	} catch (std::exception &) {
+		FinishCollInfoFetch(cache, nullptr);
+	}
+}
+
+shared_ptr<const CollInfo> GetCollInfo(ClientContext &context) {
+	auto &cache = GetCollInfoCache();
+	auto disk_cache = DiskCache::Get(context, "collinfo");
+
+	std::unique_lock<std::mutex> guard(cache.lock);
+	while (true) {
+		if (cache.current && CollInfoAgeSeconds(*cache.current) < COLLINFO_TTL_SECONDS) {
+			auto collinfo = cache.current;
+			if (!cache.fetching && CollInfoAgeSeconds(*collinfo) >= COLLINFO_REFRESH_SECONDS) {
+				cache.fetching = true;
+				guard.unlock();
+				DUCKDB_LOG_DEBUG(context, "Refreshing collinfo.json in the background +%.0fms", ElapsedMs());
+				RefreshCollInfoInBackground(context, disk_cache);
+			}
+			return collinfo;
+		}
+		if (!cache.fetching) {
+			break;
+		}
+		// Another query is downloading it
+		cache.fetched.wait(guard);
+	}
+	cache.fetching = true;
+	guard.unlock();
+
+	shared_ptr<const CollInfo> collinfo;
+	try {
+		if (disk_cache) {
+			collinfo = LoadPersistedCollInfo(*disk_cache);
+		}
+		if (collinfo) {
+			DUCKDB_LOG_DEBUG(context, "Loaded collinfo.json from the cache directory +%.0fms", ElapsedMs());
+		} else {
+			DUCKDB_LOG_DEBUG(context, "Fetching collinfo.json +%.0fms", ElapsedMs());
+			EnableForceDownload(context);
+			collinfo = FetchCollInfo(FileSystem::GetFileSystem(context), disk_cache);
+		}
+	} catch (...) {
+		FinishCollInfoFetch(cache, nullptr);
+		throw;
+	}
+	DUCKDB_LOG_DEBUG(context, "Cached %lu crawl infos, latest: %s +%.0fms", (unsigned long)collinfo->crawl_infos.size(),
+	                 collinfo->latest_crawl_id.c_str(), ElapsedMs());
+	FinishCollInfoFetch(cache, collinfo);
+	return collinfo;
+}
+
+string GetLatestCrawlId(ClientContext &context) {
+	return GetCollInfo(context)->latest_crawl_id;
 }
 
 vector<string> GetCrawlIdsForTimestampRange(ClientContext &context, timestamp_t from_ts, timestamp_t to_ts) {
-	const auto &crawl_infos = GetCrawlInfos(context);
+	auto collinfo = GetCollInfo(context);
+	auto &crawls = collinfo->crawl_infos;
 	vector<string> matching_ids;
 
 	// Handle cases where one or both bounds are not specified (timestamp_t(0) means unset)
@@ -573,26 +1247,33 @@ vector<string> GetCrawlIdsForTimestampRange(ClientContext &context, timestamp_t
 	DUCKDB_LOG_DEBUG(context, "Looking for crawls in range: from=%lld to=%lld +%.0fms", (long long)from_ts.value,
 	                 (long long)to_ts.value, ElapsedMs());
 
-	for (const auto &info : crawl_infos) {
-		// A crawl overlaps with the query range if:
-		// - crawl.to >= query.from (crawl ends after or when query starts)
-		// - crawl.from <= query.to (crawl starts before or when query ends)
-		bool overlaps = true;
-
-		if (has_from && info.to_ts.value < from_ts.value) {
-			// Crawl ended before query range starts
-			overlaps = false;
-		}
-		if (has_to && info.from_ts.value > to_ts.value) {
-			// Crawl started after query range ends
-			overlaps = false;
-		}
+	// A crawl overlaps with the query range if it ends at or after query.from and starts at or before query.to.
+	// Crawls before the first one whose running maximum end reaches query.from all end too early; crawls from the
+	// first one starting after query.to all start too late.
+	idx_t begin = 0;
+	idx_t end = crawls.size();
+	if (has_from) {
+		begin = NumericCast<idx_t>(std::lower_bound(collinfo->max_to_ts.begin(), collinfo->max_to_ts.end(), from_ts) -
+		                           collinfo->max_to_ts.begin());
+	}
+	if (has_to) {
+		end = NumericCast<idx_t>(std::upper_bound(crawls.begin(), crawls.end(), to_ts,
+		                                          [](timestamp_t ts, const CrawlInfo &info) {
+			                                          return ts < info.from_ts;
+		                                          }) -
+		                         crawls.begin());
+	}
 
-		if (overlaps) {
-			matching_ids.push_back(info.id);
-			DUCKDB_LOG_DEBUG(context, "  Matched crawl: %s (from=%lld to=%lld)", info.id.c_str(),
-			                 (long long)info.from_ts.value, (long long)info.to_ts.value);
+	// Newest first, as collinfo.json lists them
+	for (idx_t i = end; i > begin; i--) {
+		auto &info = crawls[i - 1];
+		if (has_from && info.to_ts < from_ts) {
+			// Ends before the range although an earlier crawl does not (overlapping crawl periods)
+			continue;
 		}
+		matching_ids.push_back(info.id);
+		DUCKDB_LOG_DEBUG(context, "  Matched crawl: %s (from=%lld to=%lld)", info.id.c_str(),
+		                 (long long)info.from_ts.value, (long long)info.to_ts.value);
 	}
 
 	DUCKDB_LOG_DEBUG(context, "Found %lu matching crawls +%.0fms", (unsigned long)matching_ids.size(), ElapsedMs());